@@ -0,0 +1,551 @@
+/*
+ * Throughput of the library over a corpus of json documents, with jsmn and cJSON as baselines when they are
+ * available (BENCH_JSMN, BENCH_CJSON). Built by `scons bench` at -O2 and -O3, or by hand:
+ *
+ *     gcc -O3 -DJSON_INCITER_THREADS -pthread -I. bench/bench.c -o bench_O3
+ *     ./bench_O3 [-n ndjson megabytes] [-t max threads] [corpus files]
+ *
+ * The default corpus is bench/corpus/{twitter,citm_catalog,canada}.json (see bench/fetch_corpus.sh) and
+ * test/api.json; missing files are reported on stderr and skipped. A newline delimited stream, and the same records
+ * as an array for the threaded benchmarks, are generated.
+ *
+ * Every benchmark prints one CSV line on stdout, the best of BENCH_ROUNDS rounds:
+ *
+ *     build,benchmark,input,bytes,ops,ns_per_op,mb_per_s
+ *
+ * where `bytes` and `ops` are the bytes processed and the operations done by one call.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "json_inciter.h"
+
+#ifdef BENCH_JSMN
+#define JSMN_STATIC
+#include <jsmn.h>
+#endif
+
+#ifdef BENCH_CJSON
+#include <cjson/cJSON.h>
+#endif
+
+
+#ifndef BENCH_BUILD
+#define BENCH_BUILD custom
+#endif
+
+#define BENCH_STRING(Name)        #Name
+#define BENCH_EXPAND_STRING(Name) BENCH_STRING(Name)
+
+#define BENCH_ROUNDS     5
+#define BENCH_ROUND_TIME 0.05      // Seconds a round lasts at least
+#define BENCH_STRINGS    65536     // Strings kept for the copy benchmark, and numbers for the write benchmarks
+
+
+typedef struct {
+    const char *name;
+    const char *buffer;     // NUL terminated
+    size_t      length;
+
+    json_inciter_element_t root;
+    json_inciter_element_t strings[BENCH_STRINGS];
+    size_t                 n_strings;
+    size_t                 string_bytes;
+    double                 numbers[BENCH_STRINGS];
+    size_t                 n_numbers;
+
+    // Key searched for by the find benchmarks
+    char   key[64];
+    size_t key_offset;     // Offset of the value found, i.e. the bytes scanned
+
+#ifdef BENCH_JSMN
+    jsmntok_t *tokens;
+    size_t     n_tokens;
+#endif
+} input_t;
+
+
+typedef size_t (*operation_t)(input_t *input);
+
+
+typedef struct {
+    double sum;
+    char   padding[56];     // One cache line per context
+} context_t;
+
+
+static volatile size_t sink;
+
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+
+// Run `operation` in rounds long enough to be timed, and print the best one
+static void measure(const char *benchmark, input_t *input, operation_t operation, size_t bytes, size_t ops) {
+    size_t calls = 1;
+    double best  = 0;
+
+    for (;;) {
+        double start = now();
+        for (size_t i = 0; i < calls; i++) {
+            sink += operation(input);
+        }
+        if (now() - start >= BENCH_ROUND_TIME) {
+            break;
+        }
+        calls *= 2;
+    }
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        double start = now();
+        for (size_t i = 0; i < calls; i++) {
+            sink += operation(input);
+        }
+        double elapsed = (now() - start) / (double)calls;
+        best           = round == 0 || elapsed < best ? elapsed : best;
+    }
+
+    printf("%s,%s,%s,%zu,%zu,%.1f,%.1f\n", BENCH_EXPAND_STRING(BENCH_BUILD), benchmark, input->name, bytes, ops,
+           best * 1e9 / (double)ops, (double)bytes / best / 1e6);
+    fflush(stdout);
+}
+
+
+static size_t parse_value(input_t *input) {
+    json_inciter_element_t root = {0};
+    return json_inciter_parse_value_n(input->buffer, input->length, &root) == JSON_INCITER_OK ? root.length : 0;
+}
+
+
+static size_t validate(input_t *input) {
+    return json_inciter_validate_n(input->buffer, input->length) == JSON_INCITER_OK;
+}
+
+
+// Count the values of a container and of everything nested in it
+static size_t iterate_container(json_inciter_element_t container) {
+    json_inciter_iter_t    iter;
+    json_inciter_element_t value  = {0};
+    size_t                 values = 1;
+
+    if (json_inciter_iter_init(&iter, container) != JSON_INCITER_OK) {
+        return 1;
+    }
+    while (json_inciter_iter_next(&iter, NULL, &value) == JSON_INCITER_OK) {
+        values += iterate_container(value);
+    }
+    return values;
+}
+
+
+static size_t iterate(input_t *input) {
+    return iterate_container(input->root);
+}
+
+
+static json_inciter_action_t count_event(void *context, json_inciter_event_t event,
+                                         const json_inciter_element_t *element) {
+    (void)event;
+    (void)element;
+    (*(size_t *)context)++;
+    return JSON_INCITER_ACTION_CONTINUE;
+}
+
+
+static size_t walk(input_t *input) {
+    size_t events = 0;
+    json_inciter_walk_n(input->buffer, input->length, 0, count_event, &events);
+    return events;
+}
+
+
+static size_t find_value(input_t *input) {
+    json_inciter_element_t value = {0};
+    return json_inciter_find_value_in_object(input->root, input->key, &value) == JSON_INCITER_OK;
+}
+
+
+static size_t copy_content(input_t *input) {
+    static char content[1 << 16];
+    size_t      copied = 0;
+
+    for (size_t i = 0; i < input->n_strings; i++) {
+        copied += json_inciter_copy_content(content, sizeof(content), input->strings[i]) == 0;
+    }
+    return copied;
+}
+
+
+// Output of the writer benchmarks, counted and dropped
+static char   output[1 << 12];
+static size_t output_bytes;
+
+
+static json_inciter_t discard(void *context, const char *data, size_t length) {
+    (void)context;
+    (void)data;
+    output_bytes += length;
+    return JSON_INCITER_OK;
+}
+
+
+// Write the document again: keys and strings are forwarded, numbers are formatted
+static json_inciter_action_t write_event(void *context, json_inciter_event_t event,
+                                         const json_inciter_element_t *element) {
+    json_inciter_writer_t *writer = context;
+
+    if (event == JSON_INCITER_EVENT_BEGIN_OBJECT) {
+        json_inciter_write_begin_object(writer);
+    } else if (event == JSON_INCITER_EVENT_END_OBJECT) {
+        json_inciter_write_end_object(writer);
+    } else if (event == JSON_INCITER_EVENT_BEGIN_ARRAY) {
+        json_inciter_write_begin_array(writer);
+    } else if (event == JSON_INCITER_EVENT_END_ARRAY) {
+        json_inciter_write_end_array(writer);
+    } else if (event == JSON_INCITER_EVENT_KEY) {
+        json_inciter_write_key_element(writer, *element);
+    } else if (element->tag == JSON_INCITER_ELEMENT_TAG_NUMBER) {
+        json_inciter_write_double(writer, element->as.number);
+    } else {
+        json_inciter_write_element(writer, *element);
+    }
+    return JSON_INCITER_ACTION_CONTINUE;
+}
+
+
+static size_t rewrite(input_t *input) {
+    json_inciter_writer_t writer;
+
+    output_bytes = 0;
+    json_inciter_writer_init(&writer, output, sizeof(output), discard, NULL);
+    json_inciter_walk_n(input->buffer, input->length, 0, write_event, &writer);
+    return json_inciter_writer_flush(&writer) == JSON_INCITER_OK ? output_bytes : 0;
+}
+
+
+static size_t write_double(input_t *input) {
+    json_inciter_writer_t writer;
+
+    output_bytes = 0;
+    json_inciter_writer_init(&writer, output, sizeof(output), discard, NULL);
+    json_inciter_write_begin_array(&writer);
+    for (size_t i = 0; i < input->n_numbers; i++) {
+        json_inciter_write_double(&writer, input->numbers[i]);
+    }
+    json_inciter_write_end_array(&writer);
+    return json_inciter_writer_flush(&writer) == JSON_INCITER_OK ? output_bytes : 0;
+}
+
+
+// The usual way to print doubles that read back exactly, for comparison
+static size_t snprintf_double(input_t *input) {
+    char   number[32];
+    size_t written = 0;
+
+    for (size_t i = 0; i < input->n_numbers; i++) {
+        written += (size_t)snprintf(number, sizeof(number), "%.17g", input->numbers[i]);
+    }
+    return written;
+}
+
+
+#ifdef BENCH_JSMN
+static size_t jsmn(input_t *input) {
+    jsmn_parser parser;
+    jsmn_init(&parser);
+    return (size_t)jsmn_parse(&parser, input->buffer, input->length, input->tokens, (unsigned int)input->n_tokens);
+}
+#endif
+
+
+#ifdef BENCH_CJSON
+static size_t cjson(input_t *input) {
+    cJSON *root = cJSON_ParseWithLength(input->buffer, input->length);
+    cJSON_Delete(root);
+    return root != NULL;
+}
+#endif
+
+
+static size_t records(input_t *input) {
+    json_inciter_records_t records;
+    json_inciter_element_t record = {0};
+    size_t                 count  = 0;
+
+    json_inciter_records_init_n(&records, input->buffer, input->length);
+    while (json_inciter_records_next(&records, &record) == JSON_INCITER_OK) {
+        count++;
+    }
+    return count;
+}
+
+
+#ifdef JSON_INCITER_THREADS
+static context_t contexts[JSON_INCITER_MAX_THREADS];
+static void     *context_pointers[JSON_INCITER_MAX_THREADS];
+static size_t    n_threads;
+
+
+static json_inciter_t sum_prices(void *context, json_inciter_t result, const json_inciter_element_t *element) {
+    json_inciter_element_t price = {0};
+
+    if (result != JSON_INCITER_OK) {
+        return result;
+    }
+    if (json_inciter_find_value_in_object(*element, "price", &price) == JSON_INCITER_OK) {
+        ((context_t *)context)->sum += price.as.number;
+    }
+    return JSON_INCITER_OK;
+}
+
+
+static size_t records_parallel(input_t *input) {
+    return json_inciter_records_parallel_n(input->buffer, input->length, 0, n_threads, 0, sum_prices,
+                                           context_pointers) == JSON_INCITER_OK;
+}
+
+
+static size_t array_parallel(input_t *input) {
+    return json_inciter_array_parallel(input->root, 0, n_threads, 0, sum_prices, context_pointers) == JSON_INCITER_OK;
+}
+#endif
+
+
+// Keep the strings of a document for the copy benchmark, and its numbers for the write benchmarks
+static json_inciter_action_t collect_values(void *context, json_inciter_event_t event,
+                                            const json_inciter_element_t *element) {
+    input_t *input = context;
+
+    if (event == JSON_INCITER_EVENT_SCALAR && element->tag == JSON_INCITER_ELEMENT_TAG_STRING &&
+        input->n_strings < BENCH_STRINGS) {
+        input->strings[input->n_strings++] = *element;
+        input->string_bytes += element->length;
+    } else if (event == JSON_INCITER_EVENT_SCALAR && element->tag == JSON_INCITER_ELEMENT_TAG_NUMBER &&
+               input->n_numbers < BENCH_STRINGS) {
+        input->numbers[input->n_numbers++] = element->as.number;
+    }
+    return input->n_strings < BENCH_STRINGS || input->n_numbers < BENCH_STRINGS ? JSON_INCITER_ACTION_CONTINUE
+                                                                                 : JSON_INCITER_ACTION_STOP;
+}
+
+
+// Look for the key at `position` (first, middle or last) of the root object
+static void bench_find(input_t *input, const char *position) {
+    json_inciter_iter_t    iter;
+    json_inciter_element_t key    = {0};
+    json_inciter_element_t value  = {0};
+    size_t                 n_keys = 0;
+    size_t                 target = 0;
+    char                   benchmark[64];
+
+    json_inciter_iter_init(&iter, input->root);
+    while (json_inciter_iter_next(&iter, NULL, &value) == JSON_INCITER_OK) {
+        n_keys++;
+    }
+    target = position[0] == 'f' ? 0 : position[0] == 'm' ? n_keys / 2 : n_keys - 1;
+
+    json_inciter_iter_init(&iter, input->root);
+    for (size_t i = 0; i <= target; i++) {
+        json_inciter_iter_next(&iter, &key, &value);
+    }
+    if (json_inciter_copy_content(input->key, sizeof(input->key), key) != 0) {
+        return;
+    }
+    input->key_offset = (size_t)(value.start - input->buffer);
+
+    snprintf(benchmark, sizeof(benchmark), "find_value_%s", position);
+    measure(benchmark, input, find_value, input->key_offset, 1);
+}
+
+
+static void bench_document(input_t *input) {
+    size_t events = 0;
+
+    if (json_inciter_parse_value_n(input->buffer, input->length, &input->root) != JSON_INCITER_OK) {
+        fprintf(stderr, "# invalid %s\n", input->name);
+        return;
+    }
+    json_inciter_walk_n(input->buffer, input->length, 0, count_event, &events);
+    json_inciter_walk_n(input->buffer, input->length, 0, collect_values, input);
+
+    measure("parse_value", input, parse_value, input->length, 1);
+    measure("validate", input, validate, input->length, 1);
+    measure("iterate", input, iterate, input->length, iterate(input));
+    measure("walk", input, walk, input->length, events);
+    if (input->root.tag == JSON_INCITER_ELEMENT_TAG_OBJECT) {
+        bench_find(input, "first");
+        bench_find(input, "middle");
+        bench_find(input, "last");
+    }
+    if (input->n_strings > 0) {
+        measure("copy_content", input, copy_content, input->string_bytes, input->n_strings);
+    }
+    measure("rewrite", input, rewrite, rewrite(input), events);
+    if (input->n_numbers > 0) {
+        measure("write_double", input, write_double, write_double(input), input->n_numbers);
+        measure("snprintf_double", input, snprintf_double, snprintf_double(input), input->n_numbers);
+    }
+
+#ifdef BENCH_JSMN
+    jsmn_parser parser;
+    jsmn_init(&parser);
+    input->n_tokens = (size_t)jsmn_parse(&parser, input->buffer, input->length, NULL, 0);
+    input->tokens   = malloc(input->n_tokens * sizeof(jsmntok_t));
+    if (input->tokens != NULL) {
+        measure("jsmn_parse", input, jsmn, input->length, 1);
+        free(input->tokens);
+    }
+#endif
+#ifdef BENCH_CJSON
+    measure("cjson_parse", input, cjson, input->length, 1);
+#endif
+}
+
+
+// Fill `buffer` with records of a few members, separated by `separator`, and return the length written
+static size_t generate(char *buffer, size_t size, const char *separator) {
+    size_t length = 0;
+    for (int i = 0; length < size - 256; i++) {
+        length += (size_t)snprintf(&buffer[length], size - length,
+                                   "%s{\"id\": %d, \"name\": \"item %d, \\\"quoted\\\"\", \"tags\": [\"a\", \"b\"], "
+                                   "\"price\": %d.25}",
+                                   i > 0 ? separator : "", i, i, i % 1000);
+    }
+    return length;
+}
+
+
+static void bench_records(size_t megabytes, size_t max_threads) {
+    size_t   size   = megabytes << 20;
+    char    *buffer = malloc(size + 2);
+    input_t *input  = calloc(1, sizeof(input_t));
+
+    if (buffer == NULL || input == NULL || size < 1024) {
+        free(buffer);
+        free(input);
+        return;
+    }
+
+    input->name   = "ndjson";
+    input->buffer = buffer;
+    input->length = generate(buffer, size, "\n");
+    measure("records", input, records, input->length, records(input));
+
+#ifdef JSON_INCITER_THREADS
+    for (n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+        char benchmark[64];
+        snprintf(benchmark, sizeof(benchmark), "records_parallel_t%zu", n_threads);
+        measure(benchmark, input, records_parallel, input->length, 1);
+    }
+
+    // The same records, as an array
+    input->name   = "array";
+    buffer[0]     = '[';
+    input->length = 1 + generate(&buffer[1], size, ", ");
+
+    buffer[input->length++] = ']';
+    buffer[input->length]   = '\0';
+    if (json_inciter_parse_value_n(buffer, input->length, &input->root) == JSON_INCITER_OK) {
+        for (n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+            char benchmark[64];
+            snprintf(benchmark, sizeof(benchmark), "array_parallel_t%zu", n_threads);
+            measure(benchmark, input, array_parallel, input->length, 1);
+        }
+    }
+#else
+    (void)max_threads;
+#endif
+
+    free(input);
+    free(buffer);
+}
+
+
+// Read a whole file, NUL terminated
+static char *load(const char *path, size_t *length) {
+    FILE *file   = fopen(path, "rb");
+    char *buffer = NULL;
+    long  size   = 0;
+
+    if (file == NULL || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0 ||
+        (buffer = malloc((size_t)size + 1)) == NULL || fread(buffer, 1, (size_t)size, file) != (size_t)size) {
+        free(buffer);
+        buffer = NULL;
+    } else {
+        buffer[size] = '\0';
+        *length      = (size_t)size;
+    }
+    if (file != NULL) {
+        fclose(file);
+    }
+    return buffer;
+}
+
+
+int main(int argc, char **argv) {
+    static const char *default_corpus[] = {
+        "bench/corpus/twitter.json",
+        "bench/corpus/citm_catalog.json",
+        "bench/corpus/canada.json",
+        "test/api.json",
+    };
+    const char *const *corpus      = default_corpus;
+    size_t             n_files     = sizeof(default_corpus) / sizeof(default_corpus[0]);
+    size_t             megabytes   = 64;
+    size_t             max_threads = 2 * (size_t)sysconf(_SC_NPROCESSORS_ONLN);
+    int                option;
+
+    while ((option = getopt(argc, argv, "n:t:")) != -1) {
+        if (option == 'n') {
+            megabytes = (size_t)atoi(optarg);
+        } else if (option == 't') {
+            max_threads = (size_t)atoi(optarg);
+        } else {
+            fprintf(stderr, "usage: %s [-n ndjson megabytes] [-t max threads] [corpus files]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind < argc) {
+        corpus  = (const char *const *)&argv[optind];
+        n_files = (size_t)(argc - optind);
+    }
+
+#ifdef JSON_INCITER_THREADS
+    if (max_threads > JSON_INCITER_MAX_THREADS) {
+        max_threads = JSON_INCITER_MAX_THREADS;
+    }
+    for (size_t i = 0; i < JSON_INCITER_MAX_THREADS; i++) {
+        context_pointers[i] = &contexts[i];
+    }
+#endif
+
+    printf("build,benchmark,input,bytes,ops,ns_per_op,mb_per_s\n");
+    for (size_t i = 0; i < n_files; i++) {
+        input_t *input = calloc(1, sizeof(input_t));
+        char    *buffer;
+
+        if (input == NULL || (buffer = load(corpus[i], &input->length)) == NULL) {
+            fprintf(stderr, "# missing %s\n", corpus[i]);
+            free(input);
+            continue;
+        }
+
+        const char *name = strrchr(corpus[i], '/');
+        input->name      = name != NULL ? name + 1 : corpus[i];
+        input->buffer    = buffer;
+        bench_document(input);
+
+        free(buffer);
+        free(input);
+    }
+    bench_records(megabytes, max_threads);
+
+    return 0;
+}
@@ -0,0 +1,8 @@
+#!/bin/sh
+# Download the standard json benchmark corpus into bench/corpus
+set -e
+cd "$(dirname "$0")"
+mkdir -p corpus
+for file in twitter.json citm_catalog.json canada.json; do
+    [ -f "corpus/$file" ] || curl -fsSL -o "corpus/$file" "https://raw.githubusercontent.com/simdjson/simdjson/master/jsonexamples/$file"
+done
@@ -5,8 +5,46 @@
 
 
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include <float.h>
+#include <locale.h>
+
+// Define JSON_INCITER_THREADS to process newline delimited records with a pool of POSIX threads
+#ifdef JSON_INCITER_THREADS
+#include <pthread.h>
+#endif
+
+// Define JSON_INCITER_MMAP to map json files into memory on POSIX systems
+#ifdef JSON_INCITER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Define JSON_INCITER_STATS to keep per thread counters of the work done, see `json_inciter_stats_snapshot`
+
+// Vectorized scanners are selected at compile time; define JSON_INCITER_NO_SIMD to force the scalar ones
+#if !defined(JSON_INCITER_NO_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define _JSON_INCITER_SIMD_AVX2
+#define _JSON_INCITER_SIMD_SSE2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define _JSON_INCITER_SIMD_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define _JSON_INCITER_SIMD_NEON
+#endif
+#endif
+
+#if defined(_JSON_INCITER_SIMD_SSE2) || defined(_JSON_INCITER_SIMD_NEON)
+#define _JSON_INCITER_SIMD
+#endif
 
 
 /**
@@ -19,7 +57,8 @@
 #define JSON_INCITER_STRING_LENGTH(Element) ((Element).length - 2)
 
 /**
- * @brief Pointer to the remaining json, after the current element
+ * @brief Pointer to the remaining json, after the current element. Containers parsed with
+ * JSON_INCITER_FLAG_LAZY_CONTAINERS need `json_inciter_element_next_start` instead.
  *
  * @param Element element in question
  *
@@ -27,6 +66,78 @@
  */
 #define JSON_INCITER_ELEMENT_NEXT_START(Element) ((Element).start + (Element).length)
 
+/**
+ * @brief Maximum number of keys that can be looked for at once by `json_inciter_find_values_in_object`
+ */
+#define JSON_INCITER_MAX_KEYS 32
+
+/**
+ * @brief Deepest nesting of arrays and objects accepted by `json_inciter_validate_n`, which keeps one bit per level
+ * on the stack
+ */
+#ifndef JSON_INCITER_MAX_DEPTH
+#define JSON_INCITER_MAX_DEPTH 1024
+#endif
+
+/**
+ * @brief Most threads `json_inciter_records_parallel_n` can be asked for
+ */
+#ifndef JSON_INCITER_MAX_THREADS
+#define JSON_INCITER_MAX_THREADS 64
+#endif
+
+/**
+ * @brief Precompiled key for a string literal, its length being known at compile time
+ *
+ * @param Literal key, as a string literal
+ *
+ * @return json_inciter_key_t
+ */
+#define JSON_INCITER_KEY(Literal) json_inciter_key_make_n("" Literal "", sizeof(Literal) - 1)
+
+/**
+ * @brief Descriptor of a struct member bound to a key (see `json_inciter_bind_object`)
+ *
+ * @param Key key, as a string literal
+ * @param Type json_inciter_field_type_t
+ * @param Struct struct type
+ * @param Member member of the struct
+ *
+ * @return json_inciter_field_t initializer
+ */
+#define JSON_INCITER_FIELD(Key, Type, Struct, Member)                                                                  \
+    { "" Key "", sizeof(Key) - 1, (Type), offsetof(Struct, Member), sizeof(((Struct *)0)->Member), NULL, 0 }
+
+/**
+ * @brief Descriptor of a struct member bound to a nested object, itself described by an array of descriptors
+ *
+ * @param Key key, as a string literal
+ * @param Struct struct type
+ * @param Member member of the struct
+ * @param Fields array of the descriptors of the nested object
+ *
+ * @return json_inciter_field_t initializer
+ */
+#define JSON_INCITER_FIELD_OBJECT(Key, Struct, Member, Fields)                                                         \
+    {                                                                                                                  \
+        "" Key "", sizeof(Key) - 1, JSON_INCITER_FIELD_TYPE_OBJECT, offsetof(Struct, Member),                         \
+            sizeof(((Struct *)0)->Member), (Fields), sizeof(Fields) / sizeof((Fields)[0])                              \
+    }
+
+/**
+ * @brief Number of `uint32_t` words taken by each entry of a tape (see `json_inciter_tape_build_n`)
+ */
+#define JSON_INCITER_TAPE_ENTRY_WORDS 3
+
+/**
+ * @brief Size, in `uint32_t` words, of a tape holding a given number of entries
+ *
+ * @param Entries number of entries (one per value and one per object key)
+ *
+ * @return Number of words
+ */
+#define JSON_INCITER_TAPE_WORDS(Entries) ((Entries)*JSON_INCITER_TAPE_ENTRY_WORDS)
+
 
 /**
  * @brief State of the json stream
@@ -37,6 +148,7 @@ typedef enum {
     JSON_INCITER_INVALID,        // Invalid json
     JSON_INCITER_INCOMPLETE,     // Incomplete json (requires more character to successfully parse the next
                                  // element)
+    JSON_INCITER_OVERFLOW,       // Valid json, but the value does not fit the requested type
 } json_inciter_t;
 
 
@@ -54,14 +166,26 @@ typedef enum {
 } json_inciter_element_tag_t;
 
 
+/**
+ * @brief Parsing modes, set by the caller in the `flags` of the element to be parsed into
+ */
+typedef enum {
+    JSON_INCITER_FLAG_LAZY_NUMBERS    = 0x01,     // Numbers are only scanned, see `json_inciter_element_as_double`
+    JSON_INCITER_FLAG_LAZY_CONTAINERS = 0x02,     // Arrays and objects end where first needed, see
+                                                  // `json_inciter_element_resolve`
+} json_inciter_flag_t;
+
+
 /**
  * @brief JSON element, after being parsed.
  */
 typedef struct {
-    json_inciter_element_tag_t tag;     // Tag
+    json_inciter_element_tag_t tag;       // Tag
+    uint8_t                    flags;     // Parsing mode (json_inciter_flag_t), kept across parses
 
     const char *start;      // Pointer to the string that makes up the element, in the original json stream
-    size_t      length;     // Length of the string that makes up the element
+    size_t      length;     // Length of the string that makes up the element (the bytes left in the stream, for a
+                            // container whose end is not resolved yet)
 
     union {
         double      number;     // Numerical value
@@ -70,10 +194,305 @@ typedef struct {
 } json_inciter_element_t;
 
 
+/**
+ * @brief Pull iterator over the members of an array or object, see `json_inciter_iter_init`
+ */
+typedef struct {
+    const char                *buffer;      // Container, from its opening bracket
+    size_t                     length;      // Bytes available in `buffer`; can grow after JSON_INCITER_INCOMPLETE
+    size_t                     offset;      // Offset of the next separator, or of a lazy value still to be skipped
+    json_inciter_element_tag_t tag;         // JSON_INCITER_ELEMENT_TAG_ARRAY or JSON_INCITER_ELEMENT_TAG_OBJECT
+    uint8_t                    state;       // Private iteration state
+} json_inciter_iter_t;
+
+
+/**
+ * @brief Caller owned state of a parse interrupted by the end of the stream (see
+ * `json_inciter_parse_value_resume_n`). Must be zero initialized before parsing a new value.
+ */
+typedef struct {
+    size_t  value_offset;     // Offset of the value being parsed, after leading whitespace
+    size_t  offset;           // Offset where the scan resumes
+    size_t  object_depth;     // Nested objects currently open
+    size_t  array_depth;      // Nested arrays currently open
+    uint8_t state;            // Private scanner flags
+} json_inciter_continuation_t;
+
+
+/**
+ * @brief Precompiled key, see `JSON_INCITER_KEY`. Members whose key differs in length or in its first 8 bytes are
+ * rejected without comparing strings.
+ */
+typedef struct {
+    const char *key;        // Key (not necessarily NUL terminated)
+    size_t      length;     // Length of the key
+    uint64_t    prefix;     // First 8 bytes of the key, zero padded, as loaded from memory
+    uint32_t    hash;       // Hash of the key, as used by key indexes
+} json_inciter_key_t;
+
+
+/**
+ * @brief Type of a struct member bound to a key
+ */
+typedef enum {
+    JSON_INCITER_FIELD_TYPE_INT = 0,     // Signed integer of 1, 2, 4 or 8 bytes
+    JSON_INCITER_FIELD_TYPE_UINT,        // Unsigned integer of 1, 2, 4 or 8 bytes
+    JSON_INCITER_FIELD_TYPE_DOUBLE,      // float or double
+    JSON_INCITER_FIELD_TYPE_BOOL,        // Unsigned integer set to 1 or 0, from `true` or `false`
+    JSON_INCITER_FIELD_TYPE_STRING,      // Character array, filled with the NUL terminated, unescaped, content of a
+                                         // string
+    JSON_INCITER_FIELD_TYPE_ELEMENT,     // json_inciter_element_t, any value
+    JSON_INCITER_FIELD_TYPE_OBJECT,      // Nested struct, bound to an object through its own descriptors
+} json_inciter_field_type_t;
+
+
+/**
+ * @brief Struct member bound to a key, see `JSON_INCITER_FIELD` and `JSON_INCITER_FIELD_OBJECT`
+ */
+typedef struct json_inciter_field_s {
+    const char                        *key;            // Key
+    size_t                             key_length;     // Length of the key
+    json_inciter_field_type_t          type;           // Type of the member
+    size_t                             offset;         // Offset of the member in the struct
+    size_t                             size;           // Size of the member
+    const struct json_inciter_field_s *fields;         // Descriptors of a nested object
+    size_t                             n_fields;       // Number of descriptors of a nested object
+} json_inciter_field_t;
+
+
+/**
+ * @brief Slot of a key index, an open addressing table filled by `json_inciter_key_index_build`
+ */
+typedef struct {
+    const char *key;            // Key, within quotes and possibly escaped, as found in the json stream
+    const char *value;          // Start of the value, NULL for an empty slot
+    uint32_t    key_length;     // Length of the key as found in the json stream
+    uint32_t    hash;           // Hash of the unescaped key
+    uint8_t     escaped;        // Whether the key holds escape sequences
+} json_inciter_key_slot_t;
+
+
+/**
+ * @brief Cursor over the records of a newline delimited json buffer (NDJSON, JSON Lines), see
+ * `json_inciter_records_init_n`
+ */
+typedef struct {
+    const char *buffer;     // Records, one json value per line
+    size_t      length;     // Number of bytes available in `buffer`
+    size_t      offset;     // Offset of the next line
+    size_t      line;       // Line of the last record returned, from 1
+} json_inciter_records_t;
+
+
+/**
+ * @brief Called by `json_inciter_records_parallel_n` for every record (and by `json_inciter_array_parallel` for every
+ * element), with the result of parsing it and the context of the worker (or of the range, when the order is
+ * preserved). Anything but JSON_INCITER_OK stops the worker.
+ */
+typedef json_inciter_t (*json_inciter_record_callback_t)(void *context, json_inciter_t result,
+                                                         const json_inciter_element_t *record);
+
+
+/**
+ * @brief Read only view of a file mapped into memory, see `json_inciter_file_map`
+ */
+typedef struct {
+    const char *buffer;     // Contents of the file (not NUL terminated), to be parsed with the `_n` functions
+    size_t      length;     // Size of the file
+} json_inciter_file_t;
+
+
+/**
+ * @brief Contiguous piece of a json stream, see `json_inciter_segments_t`
+ */
+typedef struct {
+    const char *buffer;     // Bytes of the segment
+    size_t      length;     // Number of bytes in the segment
+} json_inciter_segment_t;
+
+
+/**
+ * @brief Cursor over a json stream spread across segments (halves of a ring buffer, chains of receive buffers), see
+ * `json_inciter_segments_init`. Elements lying in a single segment point into it; the few that straddle a boundary
+ * are copied into the caller provided scratch buffer.
+ */
+typedef struct {
+    const json_inciter_segment_t *segments;         // Segments, in stream order; more can be appended between calls
+    size_t                        n_segments;       // Number of segments
+    size_t                        segment;          // Segment of the cursor
+    size_t                        offset;           // Offset of the cursor in its segment
+    char                         *scratch;          // Room for the elements that straddle segments
+    size_t                        scratch_size;     // Size of `scratch`
+    size_t                        scratch_used;     // Scratch taken by a key, kept until its value is parsed
+    size_t                        required;         // Scratch size the last call needed, when it was too small
+    uint8_t                       copied;           // Whether the last call copied its element into `scratch`
+} json_inciter_segments_t;
+
+
+/**
+ * @brief Events of `json_inciter_walk_n`
+ */
+typedef enum {
+    JSON_INCITER_EVENT_BEGIN_OBJECT = 0,     // Opening brace, the element holds it
+    JSON_INCITER_EVENT_END_OBJECT,           // Closing brace, the element holds it
+    JSON_INCITER_EVENT_BEGIN_ARRAY,          // Opening bracket, the element holds it
+    JSON_INCITER_EVENT_END_ARRAY,            // Closing bracket, the element holds it
+    JSON_INCITER_EVENT_KEY,                  // Object key, as a string element
+    JSON_INCITER_EVENT_SCALAR,               // String, number or literal value
+} json_inciter_event_t;
+
+
+/**
+ * @brief What `json_inciter_walk_n` does after an event
+ */
+typedef enum {
+    JSON_INCITER_ACTION_CONTINUE = 0,     // Go on with the next event
+    JSON_INCITER_ACTION_SKIP,             // After a begin event, skip the container up to its end (no end event); after
+                                          // a key, skip its value; ignored otherwise
+    JSON_INCITER_ACTION_STOP,             // Stop the walk
+} json_inciter_action_t;
+
+
+/**
+ * @brief Called by `json_inciter_walk_n` for every event, with the element it concerns
+ */
+typedef json_inciter_action_t (*json_inciter_event_callback_t)(void *context, json_inciter_event_t event,
+                                                                const json_inciter_element_t *element);
+
+
+/**
+ * @brief Called by `json_inciter_writer_t` with the output written so far, when its buffer is full and when flushed.
+ * Anything but JSON_INCITER_OK fails the writer.
+ */
+typedef json_inciter_t (*json_inciter_flush_callback_t)(void *context, const char *data, size_t length);
+
+
+/**
+ * @brief Streaming json writer over a caller provided buffer, see `json_inciter_writer_init`
+ */
+typedef struct {
+    char                         *buffer;      // Output
+    size_t                        size;        // Size of `buffer`
+    size_t                        used;        // Bytes written into `buffer` and not flushed yet
+    json_inciter_flush_callback_t flush;       // Takes the output when `buffer` is full; NULL to fail instead
+    void                         *context;     // Passed to `flush`
+    json_inciter_t                error;       // First error, returned by every later call
+    size_t                        depth;       // Containers open
+    uint8_t                       state;       // Private state of the innermost container
+    uint8_t objects[(JSON_INCITER_MAX_DEPTH + 7) / 8];     // One bit per open container, set for objects
+} json_inciter_writer_t;
+
+
+#ifdef JSON_INCITER_STATS
+/**
+ * @brief Functions whose calls and bytes are counted by JSON_INCITER_STATS; calls made by other functions count too
+ */
+typedef enum {
+    JSON_INCITER_STATS_PARSE = 0,     // `json_inciter_parse_value_n` and `json_inciter_parse_value_resume_n`
+    JSON_INCITER_STATS_FIND,          // Key searches in objects
+    JSON_INCITER_STATS_PATH,          // `json_inciter_find_path_n`
+    JSON_INCITER_STATS_ITER,          // `json_inciter_iter_next`
+    JSON_INCITER_STATS_VALIDATE,      // `json_inciter_validate_n`
+    JSON_INCITER_STATS_WALK,          // `json_inciter_walk_n`
+    JSON_INCITER_STATS_TAPE,          // `json_inciter_tape_build_n`
+    JSON_INCITER_STATS_RECORDS,       // `json_inciter_records_next`
+    JSON_INCITER_STATS_APIS,
+} json_inciter_stats_api_t;
+
+
+/**
+ * @brief Counters kept by JSON_INCITER_STATS, see `json_inciter_stats_snapshot`
+ */
+typedef struct {
+    uint64_t calls[JSON_INCITER_STATS_APIS];     // Calls per function
+    uint64_t bytes[JSON_INCITER_STATS_APIS];     // Bytes of json walked by the calls, per function
+    uint64_t container_scans;                    // Scans for the end of an array or object, each reading it whole
+    uint64_t container_scan_bytes;               // Bytes read by those scans, far above the bytes walked on rescans
+    uint64_t number_conversions;                 // Numbers converted to double
+    uint64_t literal_checks;                     // `true`, `false` and `null` checked
+    uint64_t incomplete;                         // Parses that ran out of stream
+    uint64_t resumes;                            // Parses resumed with a continuation after running out of stream
+} json_inciter_stats_t;
+#endif
+
+
 /*
  * Private types and functions
  */
 
+// Continuation flags
+#define _JSON_INCITER_SCAN_VALUE  0x01     // Value start was found
+#define _JSON_INCITER_SCAN_STRING 0x02     // Scan stopped inside a string
+#define _JSON_INCITER_SCAN_ESCAPE 0x04     // Scan stopped right after a backslash
+#define _JSON_INCITER_SCAN_FINAL  0x08     // The end of the buffer is the end of the document
+
+// Zero initializer of a struct, which C++ only accepts empty for structs starting with an enum
+#ifdef __cplusplus
+#define _JSON_INCITER_ZERO {}
+#else
+#define _JSON_INCITER_ZERO {0}
+#endif
+
+// Element flag of a lazy container whose end has not been found yet
+#define _JSON_INCITER_FLAG_UNRESOLVED 0x80
+
+// Iterator states, the position of the cursor
+#define _JSON_INCITER_ITER_FIRST   0     // Right after the opening bracket
+#define _JSON_INCITER_ITER_MEMBER  1     // Right after a member
+#define _JSON_INCITER_ITER_PENDING 2     // On a lazy container returned unresolved, to be skipped
+#define _JSON_INCITER_ITER_DONE    3     // Past the closing bracket
+
+// Writer states, per container
+#define _JSON_INCITER_WRITER_MEMBER 0x01     // A member was written, the next one needs a separator
+#define _JSON_INCITER_WRITER_KEY    0x02     // A key was written, its value is expected
+
+// Tape entry layout: offset of the element, offset past its end, then its tag and the index of the entry that
+// follows its subtree
+#define _JSON_INCITER_TAPE_OFFSET    0
+#define _JSON_INCITER_TAPE_END       1
+#define _JSON_INCITER_TAPE_LINK      2
+#define _JSON_INCITER_TAPE_TAG_SHIFT 28
+#define _JSON_INCITER_TAPE_NEXT_MASK 0x0FFFFFFFu     // Also marks the absence of an open container while building
+
+// Length to use when the buffer is only terminated by a NUL character
+#define _JSON_INCITER_UNBOUNDED SIZE_MAX
+
+// Bytes left after `Index`, keeping a NUL terminated buffer unbounded
+#define _JSON_INCITER_REMAINING(Length, Index) ((Length) == _JSON_INCITER_UNBOUNDED ? (Length) : (Length) - (Index))
+
+// Whether `Index` is past the end of the stream, either because the explicit length is exhausted or because a NUL
+// terminator was found
+#define _JSON_INCITER_AT_END(Buffer, Length, Index) ((Index) >= (Length) || (Buffer)[Index] == '\0')
+
+// Counters, per thread unless the thread bound its own (see `json_inciter_stats_bind`); compiled out by default
+#ifdef JSON_INCITER_STATS
+#if defined(_MSC_VER)
+#define _JSON_INCITER_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define _JSON_INCITER_THREAD_LOCAL _Thread_local
+#else
+#define _JSON_INCITER_THREAD_LOCAL __thread
+#endif
+
+static _JSON_INCITER_THREAD_LOCAL json_inciter_stats_t  _json_inciter_stats_local;
+static _JSON_INCITER_THREAD_LOCAL json_inciter_stats_t *_json_inciter_stats_bound;
+
+#define _JSON_INCITER_STATS (_json_inciter_stats_bound != NULL ? _json_inciter_stats_bound : &_json_inciter_stats_local)
+#define _JSON_INCITER_STATS_ADD(Counter, Amount) (_JSON_INCITER_STATS->Counter += (uint64_t)(Amount))
+
+// Add counters to others, all of them being 64 bit integers
+static inline void _json_inciter_stats_add(json_inciter_stats_t *stats, const json_inciter_stats_t *other) {
+    uint64_t       *counters       = (uint64_t *)stats;
+    const uint64_t *other_counters = (const uint64_t *)other;
+
+    for (size_t i = 0; i < sizeof(*stats) / sizeof(uint64_t); i++) {
+        counters[i] += other_counters[i];
+    }
+}
+#else
+#define _JSON_INCITER_STATS_ADD(Counter, Amount) ((void)0)
+#endif
+
 typedef enum {
     _JSON_INCITER_TOKEN_ANY = 0,
     _JSON_INCITER_TOKEN_KEYWORD,
@@ -84,34 +503,254 @@ typedef enum {
 } _json_inciter_token_t;
 
 
-size_t _json_inciter_skip_whitespace(const char *buffer) {
+// Character classes; the three most significant bits hold the token type a value starting with the character has
+#define _JSON_INCITER_CLASS_WHITESPACE     0x01     // Insignificant whitespace
+#define _JSON_INCITER_CLASS_TERMINATOR     0x02     // Can follow a literal or a number
+#define _JSON_INCITER_CLASS_DIGIT          0x04     // Decimal digit
+#define _JSON_INCITER_CLASS_STRUCTURAL     0x08     // Stops the container scan: brackets, quote and NUL
+#define _JSON_INCITER_CLASS_STRING_SPECIAL 0x10     // Stops the string scan: quote, backslash and NUL
+#define _JSON_INCITER_CLASS_TOKEN_SHIFT    5
+
+#define _JSON_INCITER_CHAR_CLASS(Char) (_json_inciter_char_class[(uint8_t)(Char)])
+
+static const uint8_t _json_inciter_char_class[256] = {
+    0x3A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x23, 0x23, 0x20, 0x20, 0x23, 0x20, 0x20,     // 0x00 - 0x0F
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0x10 - 0x1F
+    0x23, 0x20, 0x78, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x40, 0x20, 0x20,     // 0x20 - 0x2F
+    0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0x30 - 0x3F
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0x40 - 0x4F
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x88, 0x30, 0x2A, 0x20, 0x20,     // 0x50 - 0x5F
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0x60 - 0x6F
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0xA8, 0x20, 0x2A, 0x20, 0x20,     // 0x70 - 0x7F
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0x80 - 0x8F
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0x90 - 0x9F
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0xA0 - 0xAF
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0xB0 - 0xBF
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0xC0 - 0xCF
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0xD0 - 0xDF
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0xE0 - 0xEF
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // 0xF0 - 0xFF
+};
+
+
+#ifdef _JSON_INCITER_SIMD
+
+/*
+ * Vectorized classification. Blocks are always loaded from aligned addresses: when the buffer is only NUL terminated
+ * a block may extend past the terminator, but never across a page boundary. The bytes after the terminator are
+ * ignored, so the loads are excluded from address sanitizing.
+ */
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__clang__)
+#define _JSON_INCITER_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define _JSON_INCITER_NO_SANITIZE
+#endif
+
+// Bitmasks of interesting characters in a 64 byte block, one bit per byte
+typedef struct {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t bracket;     // Any of [ ] { }
+    uint64_t nul;
+} _json_inciter_block_t;
+
+
+#if defined(_JSON_INCITER_SIMD_SSE2)
+
+_JSON_INCITER_NO_SANITIZE static inline uint32_t _json_inciter_string_mask16(const char *chunk) {
+    __m128i bytes   = _mm_load_si128((const __m128i *)chunk);
+    __m128i special = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')),
+                                   _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')),
+                                                _mm_cmpeq_epi8(bytes, _mm_setzero_si128())));
+    return (uint32_t)_mm_movemask_epi8(special);
+}
+
+// Bytes that end the ASCII fast path of the validator: quotes, backslashes, control characters and, being negative
+// as signed bytes, everything outside ASCII
+_JSON_INCITER_NO_SANITIZE static inline uint32_t _json_inciter_validate_mask16(const char *chunk) {
+    __m128i bytes   = _mm_load_si128((const __m128i *)chunk);
+    __m128i special = _mm_or_si128(_mm_cmplt_epi8(bytes, _mm_set1_epi8(0x20)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')),
+                                                _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))));
+    return (uint32_t)_mm_movemask_epi8(special);
+}
+
+#if defined(_JSON_INCITER_SIMD_AVX2)
+
+_JSON_INCITER_NO_SANITIZE static inline void _json_inciter_classify_block(const char *block,
+                                                                          _json_inciter_block_t *masks) {
+    for (size_t i = 0; i < 2; i++) {
+        __m256i  bytes   = _mm256_load_si256((const __m256i *)&block[i * 32]);
+        __m256i  bracket = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('[')),
+                                                           _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(']'))),
+                                           _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('{')),
+                                                           _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('}'))));
+        unsigned shift   = (unsigned)i * 32;
+
+        masks->quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')))
+                        << shift;
+        masks->backslash |=
+            (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))) << shift;
+        masks->bracket |= (uint64_t)(uint32_t)_mm256_movemask_epi8(bracket) << shift;
+        masks->nul |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_setzero_si256()))
+                      << shift;
+    }
+}
+
+#else
+
+_JSON_INCITER_NO_SANITIZE static inline void _json_inciter_classify_block(const char *block,
+                                                                          _json_inciter_block_t *masks) {
+    for (size_t i = 0; i < 4; i++) {
+        __m128i  bytes   = _mm_load_si128((const __m128i *)&block[i * 16]);
+        __m128i  bracket = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('[')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(']'))),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('{')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('}'))));
+        unsigned shift   = (unsigned)i * 16;
+
+        masks->quote |= (uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'))) << shift;
+        masks->backslash |= (uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))) << shift;
+        masks->bracket |= (uint64_t)_mm_movemask_epi8(bracket) << shift;
+        masks->nul |= (uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128())) << shift;
+    }
+}
+
+#endif
+
+#elif defined(_JSON_INCITER_SIMD_NEON)
+
+static inline uint32_t _json_inciter_neon_movemask(uint8x16_t matches) {
+    static const uint8_t bit_weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t           weighted        = vandq_u8(matches, vld1q_u8(bit_weights));
+    return (uint32_t)vaddv_u8(vget_low_u8(weighted)) | ((uint32_t)vaddv_u8(vget_high_u8(weighted)) << 8);
+}
+
+_JSON_INCITER_NO_SANITIZE static inline uint32_t _json_inciter_string_mask16(const char *chunk) {
+    uint8x16_t bytes = vld1q_u8((const uint8_t *)chunk);
+    return _json_inciter_neon_movemask(
+        vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('"')), vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('\\')), vceqzq_u8(bytes))));
+}
+
+_JSON_INCITER_NO_SANITIZE static inline uint32_t _json_inciter_validate_mask16(const char *chunk) {
+    int8x16_t bytes = vld1q_s8((const int8_t *)chunk);
+    return _json_inciter_neon_movemask(vorrq_u8(vcltq_s8(bytes, vdupq_n_s8(0x20)),
+                                                vorrq_u8(vceqq_s8(bytes, vdupq_n_s8('"')),
+                                                         vceqq_s8(bytes, vdupq_n_s8('\\')))));
+}
+
+_JSON_INCITER_NO_SANITIZE static inline void _json_inciter_classify_block(const char *block,
+                                                                          _json_inciter_block_t *masks) {
+    for (size_t i = 0; i < 4; i++) {
+        uint8x16_t bytes   = vld1q_u8((const uint8_t *)&block[i * 16]);
+        uint8x16_t bracket = vorrq_u8(vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('[')), vceqq_u8(bytes, vdupq_n_u8(']'))),
+                                      vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('{')), vceqq_u8(bytes, vdupq_n_u8('}'))));
+        unsigned   shift   = (unsigned)i * 16;
+
+        masks->quote |= (uint64_t)_json_inciter_neon_movemask(vceqq_u8(bytes, vdupq_n_u8('"'))) << shift;
+        masks->backslash |= (uint64_t)_json_inciter_neon_movemask(vceqq_u8(bytes, vdupq_n_u8('\\'))) << shift;
+        masks->bracket |= (uint64_t)_json_inciter_neon_movemask(bracket) << shift;
+        masks->nul |= (uint64_t)_json_inciter_neon_movemask(vceqzq_u8(bytes)) << shift;
+    }
+}
+
+#endif
+
+
+/**
+ * Characters escaped by a backslash. Odd-length backslash runs escape the following character; `carry` tells
+ * whether the first character of the block is escaped and is updated for the next block.
+ */
+static inline uint64_t _json_inciter_escaped_mask(uint64_t backslash, uint64_t *carry) {
+    const uint64_t odd_bits = 0xAAAAAAAAAAAAAAAAULL;
+
+    uint64_t potential_escape = backslash & ~*carry;
+    uint64_t maybe_escaped    = potential_escape << 1;
+    uint64_t escape_and_terminal_code =
+        ((maybe_escaped | odd_bits) - potential_escape) ^ odd_bits;     // Bit set after every run start parity
+    uint64_t escaped = escape_and_terminal_code ^ (backslash | *carry);
+
+    *carry = (escape_and_terminal_code & backslash) >> 63;
+    return escaped;
+}
+
+
+// Every bit is set to the parity of the set bits at or below its position
+static inline uint64_t _json_inciter_prefix_xor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+#else
+
+#define _JSON_INCITER_NO_SANITIZE
+
+#endif
+
+
+size_t _json_inciter_skip_whitespace(const char *buffer, size_t length) {
     size_t to_skip = 0;
-    for (;;) {
-        switch (buffer[to_skip]) {
-            case '\t':
-            case '\n':
-            case '\r':
-            case ' ':
-                to_skip++;
-                break;
-            default:
-                return to_skip;
-        }
+    while (to_skip < length && (_JSON_INCITER_CHAR_CLASS(buffer[to_skip]) & _JSON_INCITER_CLASS_WHITESPACE)) {
+        to_skip++;
     }
+    return to_skip;
 }
 
 
-size_t _json_inciter_skip_string(const char *buffer) {
+size_t _json_inciter_skip_string(const char *buffer, size_t length, uint8_t *state) {
     size_t to_skip = 0;
-    for (;;) {
+
+    // The previous scan stopped on a backslash: skip the escaped character
+    if (*state & _JSON_INCITER_SCAN_ESCAPE) {
+        if (_JSON_INCITER_AT_END(buffer, length, to_skip)) {
+            return to_skip;
+        }
+        *state &= ~_JSON_INCITER_SCAN_ESCAPE;
+        to_skip++;
+    }
+
+    while (!_JSON_INCITER_AT_END(buffer, length, to_skip)) {
+#ifdef _JSON_INCITER_SIMD
+        // Skip whole blocks without quotes, backslashes or terminators
+        if (((uintptr_t)&buffer[to_skip] % 16) == 0) {
+            while (length - to_skip >= 16) {
+                uint32_t special = _json_inciter_string_mask16(&buffer[to_skip]);
+                if (special == 0) {
+                    to_skip += 16;
+                } else {
+                    to_skip += (size_t)__builtin_ctz(special);
+                    break;
+                }
+            }
+            if (_JSON_INCITER_AT_END(buffer, length, to_skip)) {
+                break;
+            }
+        }
+#endif
+
+        // Ordinary character
+        if (!(_JSON_INCITER_CHAR_CLASS(buffer[to_skip]) & _JSON_INCITER_CLASS_STRING_SPECIAL)) {
+            to_skip++;
+            continue;
+        }
+
         switch (buffer[to_skip]) {
             case '\\':
                 to_skip++;
+                // The escaped character is missing, stream done
+                if (_JSON_INCITER_AT_END(buffer, length, to_skip)) {
+                    *state |= _JSON_INCITER_SCAN_ESCAPE;
+                    return to_skip;
+                }
                 to_skip++;     // Escaped character; no matter what it is, skip it
                 break;
 
             case '"':
-            case '\0':
                 return to_skip;
 
             default:
@@ -119,70 +758,87 @@ size_t _json_inciter_skip_string(const char *buffer) {
                 break;
         }
     }
+    return to_skip;
 }
 
 
-int _json_inciter_skip_to_terminator(const char *buffer, char terminator) {
-    size_t to_skip      = 0;
-    size_t object_depth = 0;
-    size_t array_depth  = 0;
+json_inciter_t _json_inciter_skip_to_terminator_scalar(const char *buffer, size_t length, char terminator,
+                                                       json_inciter_continuation_t *scan) {
+    size_t to_skip = scan->offset;
 
     for (;;) {
+        // Inside a string, terminator could be included but should be ignored
+        if (scan->state & _JSON_INCITER_SCAN_STRING) {
+            to_skip += _json_inciter_skip_string(&buffer[to_skip], length - to_skip, &scan->state);
+
+            // If stream is not done, skip the closing quote
+            if (!_JSON_INCITER_AT_END(buffer, length, to_skip)) {
+                scan->state &= ~_JSON_INCITER_SCAN_STRING;
+                to_skip++;
+            }
+        }
+
+        // Skip over everything that is not a bracket or a quote
+        while (to_skip < length && !(_JSON_INCITER_CHAR_CLASS(buffer[to_skip]) & _JSON_INCITER_CLASS_STRUCTURAL)) {
+            to_skip++;
+        }
+
         // Stream done
-        if (buffer[to_skip] == '\0') {
-            return to_skip;
+        if (_JSON_INCITER_AT_END(buffer, length, to_skip)) {
+            _JSON_INCITER_STATS_ADD(container_scan_bytes, to_skip - scan->offset);
+            scan->offset = to_skip;
+            return JSON_INCITER_INCOMPLETE;
         }
         // Entering in nested array
         else if (buffer[to_skip] == '[') {
-            array_depth++;
+            scan->array_depth++;
             to_skip++;
         }
         // Entering in nested object
         else if (buffer[to_skip] == '{') {
-            object_depth++;
+            scan->object_depth++;
             to_skip++;
         }
         // Out of nested array
         else if (buffer[to_skip] == ']') {
             // Reached the end of the array
-            if (terminator == ']' && array_depth == 0 && object_depth == 0) {
-                return to_skip;
+            if (terminator == ']' && scan->array_depth == 0 && scan->object_depth == 0) {
+                _JSON_INCITER_STATS_ADD(container_scan_bytes, to_skip - scan->offset);
+                scan->offset = to_skip;
+                return JSON_INCITER_OK;
             }
             // Out of an array
-            else if (array_depth > 0) {
-                array_depth--;
+            else if (scan->array_depth > 0) {
+                scan->array_depth--;
                 to_skip++;
             }
             // Array closed, but was not opened: invalid json
             else {
-                return -1;
+                return JSON_INCITER_INVALID;
             }
         }
         // Out of nested object
         else if (buffer[to_skip] == '}') {
             // Reached the end of the array
-            if (terminator == '}' && array_depth == 0 && object_depth == 0) {
-                return to_skip;
+            if (terminator == '}' && scan->array_depth == 0 && scan->object_depth == 0) {
+                _JSON_INCITER_STATS_ADD(container_scan_bytes, to_skip - scan->offset);
+                scan->offset = to_skip;
+                return JSON_INCITER_OK;
             }
             // Out of an object
-            else if (object_depth > 0) {
-                object_depth--;
+            else if (scan->object_depth > 0) {
+                scan->object_depth--;
                 to_skip++;
             }
             // Object closed, but was not opened: invalid json
             else {
-                return -1;
+                return JSON_INCITER_INVALID;
             }
         }
-        // Encountered string, terminator could be included but should be ignored
+        // Encountered string
         else if (buffer[to_skip] == '"') {
+            scan->state |= _JSON_INCITER_SCAN_STRING;
             to_skip++;
-            to_skip += _json_inciter_skip_string(&buffer[to_skip]);
-
-            // If stream is not done, skip the closing quote
-            if (buffer[to_skip] != '\0') {
-                to_skip++;
-            }
         } else {
             to_skip++;
         }
@@ -190,138 +846,486 @@ int _json_inciter_skip_to_terminator(const char *buffer, char terminator) {
 }
 
 
-_json_inciter_token_t _json_inciter_get_next_token_type(char current_char) {
-    switch (current_char) {
-        case '-':
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-            return _JSON_INCITER_TOKEN_NUMBER;
-
-        case '"':
-            return _JSON_INCITER_TOKEN_STRING;
+json_inciter_t _json_inciter_skip_to_terminator(const char *buffer, size_t length, char terminator,
+                                                json_inciter_continuation_t *scan) {
+    _JSON_INCITER_STATS_ADD(container_scans, 1);
+#ifdef _JSON_INCITER_SIMD
+    for (;;) {
+        size_t         block_start = scan->offset;
+        size_t         block_end   = (size_t)(((uintptr_t)&buffer[block_start] | 63) + 1 - (uintptr_t)buffer);
+        json_inciter_t result      = JSON_INCITER_INCOMPLETE;
 
-        case '[':
-            return _JSON_INCITER_TOKEN_ARRAY;
+        // Whole aligned block available
+        if (((uintptr_t)&buffer[block_start] % 64) == 0 && length - block_start >= 64) {
+            _json_inciter_block_t masks = {0, 0, 0, 0};
+            _json_inciter_classify_block(&buffer[block_start], &masks);
 
-        case '{':
-            return _JSON_INCITER_TOKEN_OBJECT;
+            if (masks.nul == 0) {
+                uint64_t escape_carry = (scan->state & _JSON_INCITER_SCAN_ESCAPE) ? 1 : 0;
+                uint64_t escaped      = _json_inciter_escaped_mask(masks.backslash, &escape_carry);
+                uint64_t in_string    = _json_inciter_prefix_xor(masks.quote & ~escaped);
+                if (scan->state & _JSON_INCITER_SCAN_STRING) {
+                    in_string = ~in_string;
+                }
 
-        default:
-            return _JSON_INCITER_TOKEN_KEYWORD;
+                // Backslashes outside of strings are not escapes for the scalar scanner: let it decide
+                if ((masks.backslash & ~in_string) == 0) {
+                    uint64_t structural = masks.bracket & ~in_string;
+
+                    while (structural != 0) {
+                        size_t index = block_start + (size_t)__builtin_ctzll(structural);
+                        switch (buffer[index]) {
+                            case '[':
+                                scan->array_depth++;
+                                break;
+                            case '{':
+                                scan->object_depth++;
+                                break;
+                            default:
+                                // Reached the end of the container
+                                if (buffer[index] == terminator && scan->array_depth == 0 &&
+                                    scan->object_depth == 0) {
+                                    _JSON_INCITER_STATS_ADD(container_scan_bytes, index - block_start);
+                                    scan->offset = index;
+                                    scan->state &= ~(_JSON_INCITER_SCAN_STRING | _JSON_INCITER_SCAN_ESCAPE);
+                                    return JSON_INCITER_OK;
+                                } else if (buffer[index] == ']' && scan->array_depth > 0) {
+                                    scan->array_depth--;
+                                } else if (buffer[index] == '}' && scan->object_depth > 0) {
+                                    scan->object_depth--;
+                                }
+                                // Closed, but was not opened: invalid json
+                                else {
+                                    return JSON_INCITER_INVALID;
+                                }
+                                break;
+                        }
+                        structural &= structural - 1;
+                    }
+
+                    scan->state &= ~(_JSON_INCITER_SCAN_STRING | _JSON_INCITER_SCAN_ESCAPE);
+                    if (in_string >> 63) {
+                        scan->state |= _JSON_INCITER_SCAN_STRING;
+                    }
+                    if (escape_carry) {
+                        scan->state |= _JSON_INCITER_SCAN_ESCAPE;
+                    }
+                    _JSON_INCITER_STATS_ADD(container_scan_bytes, 64);
+                    scan->offset = block_start + 64;
+                    continue;
+                }
+            }
+        }
+        // Not even a partial block left: finish with the scalar scanner
+        else if (length - block_start < 64) {
+            break;
+        }
+
+        // Unaligned start, terminator or backslash outside of a string: scalar scan up to the next block
+        result = _json_inciter_skip_to_terminator_scalar(buffer, block_end, terminator, scan);
+        if (result != JSON_INCITER_INCOMPLETE || scan->offset < block_end) {
+            return result;
+        }
     }
+#endif
+
+    return _json_inciter_skip_to_terminator_scalar(buffer, length, terminator, scan);
+}
+
+
+_json_inciter_token_t _json_inciter_get_next_token_type(char current_char) {
+    return (_json_inciter_token_t)(_JSON_INCITER_CHAR_CLASS(current_char) >> _JSON_INCITER_CLASS_TOKEN_SHIFT);
 }
 
 
-#define IS_TERMINATOR(Char)                                                                                            \
-    ((Char) == ',' || (Char) == ' ' || (Char) == '\t' || (Char) == '\n' || (Char) == '\r' || (Char) == '}' ||          \
-     (Char) == ']' || (Char) == '\0')
+#define IS_TERMINATOR(Char) (_JSON_INCITER_CHAR_CLASS(Char) & _JSON_INCITER_CLASS_TERMINATOR)
 
 
-json_inciter_t _json_inciter_parse_literal(const char *buffer, const char *keyword_str) {
-    size_t keyword_len = strlen(keyword_str);
-    size_t buffer_len  = strlen(buffer);
+#define IS_DIGIT(Char) (_JSON_INCITER_CHAR_CLASS(Char) & _JSON_INCITER_CLASS_DIGIT)
 
-    // Full keyword
-    if (keyword_len <= buffer_len) {
-        if (strncmp(buffer, keyword_str, keyword_len) == 0) {
-            if (IS_TERMINATOR(buffer[keyword_len])) {
-                return JSON_INCITER_OK;
-            } else {
-                return JSON_INCITER_INVALID;
-            }
+
+// Number as scanned from the json stream
+typedef struct {
+    uint64_t mantissa;      // First 19 significant digits
+    int64_t  exponent;      // Decimal exponent applied to the mantissa
+    size_t   length;        // Length of the number in the stream
+    uint8_t  negative;      // Minus sign
+    uint8_t  integer;       // No fraction nor exponent
+    uint8_t  truncated;     // Nonzero significant digits after the first 19
+} _json_inciter_number_t;
+
+
+size_t _json_inciter_scan_digits(const char *buffer, size_t length, size_t index, uint8_t fraction,
+                                 _json_inciter_number_t *number, size_t *significant_digits) {
+    while (!_JSON_INCITER_AT_END(buffer, length, index) && IS_DIGIT(buffer[index])) {
+        uint8_t digit = (uint8_t)(buffer[index] - '0');
+
+        // Leading zeroes are not significant
+        if (number->mantissa == 0 && digit == 0 && *significant_digits == 0) {
+            number->exponent -= fraction;
+        } else if (*significant_digits < 19) {
+            number->mantissa = number->mantissa * 10 + digit;
+            number->exponent -= fraction;
+            (*significant_digits)++;
         } else {
-            return JSON_INCITER_INVALID;
+            number->truncated |= digit != 0;
+            number->exponent += !fraction;
         }
+        index++;
+    }
+    return index;
+}
+
+
+/**
+ * Scan a number following the json grammar strictly (no leading `+`, leading zeroes, hex or special forms).
+ * A number cut by the end of the stream where a digit is still required is incomplete.
+ */
+json_inciter_t _json_inciter_scan_number(const char *buffer, size_t length, _json_inciter_number_t *number) {
+    size_t  index              = 0;
+    size_t  significant_digits = 0;
+    int64_t exponent           = 0;
+    uint8_t exponent_negative  = 0;
+
+    memset(number, 0, sizeof(*number));
+    number->integer = 1;
+
+    if (!_JSON_INCITER_AT_END(buffer, length, index) && buffer[index] == '-') {
+        number->negative = 1;
+        index++;
     }
-    // Partial keyword
-    else if (strncmp(buffer, keyword_str, buffer_len) == 0) {
+
+    // Integer part
+    if (_JSON_INCITER_AT_END(buffer, length, index)) {
         return JSON_INCITER_INCOMPLETE;
+    } else if (buffer[index] == '0') {
+        index++;
+    } else if (IS_DIGIT(buffer[index])) {
+        index = _json_inciter_scan_digits(buffer, length, index, 0, number, &significant_digits);
     } else {
         return JSON_INCITER_INVALID;
     }
+
+    // Fraction
+    if (!_JSON_INCITER_AT_END(buffer, length, index) && buffer[index] == '.') {
+        number->integer = 0;
+        index++;
+        if (_JSON_INCITER_AT_END(buffer, length, index)) {
+            return JSON_INCITER_INCOMPLETE;
+        } else if (!IS_DIGIT(buffer[index])) {
+            return JSON_INCITER_INVALID;
+        }
+        index = _json_inciter_scan_digits(buffer, length, index, 1, number, &significant_digits);
+    }
+
+    // Exponent
+    if (!_JSON_INCITER_AT_END(buffer, length, index) && (buffer[index] == 'e' || buffer[index] == 'E')) {
+        number->integer = 0;
+        index++;
+        if (!_JSON_INCITER_AT_END(buffer, length, index) && (buffer[index] == '+' || buffer[index] == '-')) {
+            exponent_negative = buffer[index] == '-';
+            index++;
+        }
+        if (_JSON_INCITER_AT_END(buffer, length, index)) {
+            return JSON_INCITER_INCOMPLETE;
+        } else if (!IS_DIGIT(buffer[index])) {
+            return JSON_INCITER_INVALID;
+        }
+        while (!_JSON_INCITER_AT_END(buffer, length, index) && IS_DIGIT(buffer[index])) {
+            // Saturate, anything this large is zero or infinity anyway
+            if (exponent < 100000) {
+                exponent = exponent * 10 + (buffer[index] - '0');
+            }
+            index++;
+        }
+    }
+
+    number->exponent += exponent_negative ? -exponent : exponent;
+    number->length = index;
+    return JSON_INCITER_OK;
 }
 
 
-json_inciter_t _json_inciter_parse_value_of_type(const char *buffer, _json_inciter_token_t token,
-                                                 json_inciter_element_t *element) {
-    size_t parsing_index = 0;
+// Significant digits that decide the rounding of any decimal number to a double: halfway points between doubles have
+// at most 767, so the digits past these only matter as a whole, through a nonzero one standing for them
+#define _JSON_INCITER_MAX_DIGITS 768
 
-    parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index]);
 
-    if (token == _JSON_INCITER_TOKEN_ANY) {
-        token = _json_inciter_get_next_token_type(buffer[parsing_index]);
+/**
+ * Convert a scanned number with `strtod`, on a copy that uses the decimal point of the current locale and is NUL
+ * terminated. Numbers too long to be copied are rebuilt from their first _JSON_INCITER_MAX_DIGITS significant digits,
+ * followed by a `1` if any of the others is nonzero, which rounds the same way.
+ */
+double _json_inciter_strtod_copy(const char *buffer, const _json_inciter_number_t *number, char decimal_point) {
+    char   number_copy[_JSON_INCITER_MAX_DIGITS + 32];
+    size_t copy_len = 0;
+
+    if (number->length < sizeof(number_copy)) {
+        for (copy_len = 0; copy_len < number->length; copy_len++) {
+            number_copy[copy_len] = buffer[copy_len] == '.' ? decimal_point : buffer[copy_len];
+        }
+        number_copy[copy_len] = '\0';
+        return strtod(number_copy, NULL);
     }
 
-    switch (token) {
-        case _JSON_INCITER_TOKEN_KEYWORD: {
-            const char *keyword_null  = "null";
-            const char *keyword_true  = "true";
-            const char *keyword_false = "false";
+    // The exponent of the scan applies to the digits of the mantissa, one more for each digit kept past them
+    char     digits[24] = {0};
+    size_t   digit_len  = 0;
+    size_t   kept       = 0;
+    int64_t  exponent   = number->exponent;
+    uint8_t  sticky     = 0;
+    uint64_t mantissa   = number->mantissa;
 
-            json_inciter_t result = JSON_INCITER_INVALID;
-            element->start        = &buffer[parsing_index];
-            element->length       = 0;
+    for (; mantissa > 0; mantissa /= 10) {
+        exponent++;
+    }
+    if (number->negative) {
+        number_copy[copy_len++] = '-';
+    }
+    for (size_t i = 0; i < number->length && buffer[i] != 'e' && buffer[i] != 'E'; i++) {
+        if (!IS_DIGIT(buffer[i]) || (kept == 0 && buffer[i] == '0')) {
+            continue;
+        } else if (kept < _JSON_INCITER_MAX_DIGITS) {
+            number_copy[copy_len++] = buffer[i];
+            kept++;
+            exponent--;
+        } else {
+            sticky |= buffer[i] != '0';
+        }
+    }
+    if (sticky) {
+        number_copy[copy_len++] = '1';
+        exponent--;
+    }
 
-            result = _json_inciter_parse_literal(&buffer[parsing_index], keyword_null);
-            if (result == JSON_INCITER_OK) {
-                element->tag    = JSON_INCITER_ELEMENT_TAG_NULL;
-                element->length = strlen(keyword_null);
-                return JSON_INCITER_OK;
-            } else if (result == JSON_INCITER_INCOMPLETE) {
-                return JSON_INCITER_INCOMPLETE;
+    number_copy[copy_len++] = 'e';
+    if (exponent < 0) {
+        number_copy[copy_len++] = '-';
+    }
+    for (uint64_t magnitude = exponent < 0 ? (uint64_t)-exponent : (uint64_t)exponent; magnitude > 0 || digit_len == 0;
+         magnitude /= 10) {
+        digits[digit_len++] = (char)('0' + magnitude % 10);
+    }
+    while (digit_len > 0) {
+        number_copy[copy_len++] = digits[--digit_len];
+    }
+    number_copy[copy_len] = '\0';
+
+    return strtod(number_copy, NULL);
+}
+
+
+/**
+ * Convert a scanned number. Values whose mantissa and power of ten are both exact doubles are computed directly
+ * (a single correctly rounded operation); everything else goes through `strtod` on a copy that uses the decimal
+ * point of the current locale.
+ */
+double _json_inciter_number_to_double(const char *buffer, size_t length, const _json_inciter_number_t *number) {
+    static const double powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const uint64_t      max_exact_mantissa = (uint64_t)1 << 53;
+
+    _JSON_INCITER_STATS_ADD(number_conversions, 1);
+
+    if (number->mantissa == 0 && !number->truncated) {
+        return number->negative ? -0.0 : 0.0;
+    }
+
+    if (!number->truncated) {
+        double value = 0;
+
+        if (number->exponent == 0) {
+            value = (double)number->mantissa;
+            return number->negative ? -value : value;
+        }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+        if (number->mantissa <= max_exact_mantissa && number->exponent >= -22 && number->exponent <= 22 + 15) {
+            uint64_t mantissa = number->mantissa;
+            int64_t  exponent = number->exponent;
+
+            // Move the excess of the exponent into the mantissa, as long as it stays exact
+            while (exponent > 22 && mantissa <= max_exact_mantissa / 10) {
+                mantissa *= 10;
+                exponent--;
             }
 
-            result = _json_inciter_parse_literal(&buffer[parsing_index], keyword_true);
-            if (result == JSON_INCITER_OK) {
-                element->tag    = JSON_INCITER_ELEMENT_TAG_TRUE;
-                element->length = strlen(keyword_true);
-                return JSON_INCITER_OK;
-            } else if (result == JSON_INCITER_INCOMPLETE) {
-                return JSON_INCITER_INCOMPLETE;
+            if (exponent <= 22) {
+                value = (double)mantissa;
+                value = exponent < 0 ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+                return number->negative ? -value : value;
             }
+        }
+#else
+        (void)powers_of_ten;
+        (void)max_exact_mantissa;
+#endif
+    }
 
-            result = _json_inciter_parse_literal(&buffer[parsing_index], keyword_false);
-            if (result == JSON_INCITER_OK) {
-                element->tag    = JSON_INCITER_ELEMENT_TAG_FALSE;
-                element->length = strlen(keyword_false);
-                return JSON_INCITER_OK;
-            } else if (result == JSON_INCITER_INCOMPLETE) {
-                return JSON_INCITER_INCOMPLETE;
+    char decimal_point = localeconv()->decimal_point[0];
+
+    // The number is followed by a character within the buffer that stops `strtod`
+    if (decimal_point == '.' && !(number->length >= length)) {
+        return strtod(buffer, NULL);
+    }
+    return _json_inciter_strtod_copy(buffer, number, decimal_point);
+}
+
+
+/**
+ * Read the integer value of a number element, failing if it has a fraction or an exponent
+ */
+json_inciter_t _json_inciter_parse_integer(json_inciter_element_t element, uint64_t *magnitude, uint8_t *negative) {
+    size_t index = 0;
+
+    if (element.tag != JSON_INCITER_ELEMENT_TAG_NUMBER || element.length == 0) {
+        return JSON_INCITER_INVALID;
+    }
+
+    *magnitude = 0;
+    *negative  = element.start[0] == '-';
+    index += *negative;
+
+    for (; index < element.length; index++) {
+        if (!IS_DIGIT(element.start[index])) {
+            return JSON_INCITER_INVALID;
+        }
+
+        uint64_t digit = (uint64_t)(element.start[index] - '0');
+        if (*magnitude > (UINT64_MAX - digit) / 10) {
+            // Keep validating the rest of the number
+            for (; index < element.length; index++) {
+                if (!IS_DIGIT(element.start[index])) {
+                    return JSON_INCITER_INVALID;
+                }
             }
+            return JSON_INCITER_OVERFLOW;
+        }
+        *magnitude = *magnitude * 10 + digit;
+    }
+
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * Recognize `null`, `true` or `false` from the first character, reading at most one byte past the keyword.
+ * When the buffer length guarantees enough bytes the last four characters are compared as a single word.
+ */
+json_inciter_t _json_inciter_parse_literal(const char *buffer, size_t length, json_inciter_element_t *element) {
+    const char                *keyword     = NULL;
+    size_t                     keyword_len = 4;
+    json_inciter_element_tag_t tag         = JSON_INCITER_ELEMENT_TAG_NULL;
 
+    _JSON_INCITER_STATS_ADD(literal_checks, 1);
+    switch (buffer[0]) {
+        case 'n':
+            keyword = "null";
+            tag     = JSON_INCITER_ELEMENT_TAG_NULL;
+            break;
+        case 't':
+            keyword = "true";
+            tag     = JSON_INCITER_ELEMENT_TAG_TRUE;
+            break;
+        case 'f':
+            keyword     = "false";
+            keyword_len = 5;
+            tag         = JSON_INCITER_ELEMENT_TAG_FALSE;
+            break;
+        default:
             return JSON_INCITER_INVALID;
+    }
+
+    uint32_t expected_word = 0;
+    uint32_t word          = 0;
+    if (length != _JSON_INCITER_UNBOUNDED && length >= keyword_len) {
+        memcpy(&expected_word, &keyword[keyword_len - 4], sizeof(expected_word));
+        memcpy(&word, &buffer[keyword_len - 4], sizeof(word));
+    }
+
+    // Mismatch, or not enough bytes known: find out byte by byte whether it is partial or wrong
+    if (word != expected_word || expected_word == 0) {
+        for (size_t i = 1; i < keyword_len; i++) {
+            // Partial keyword
+            if (_JSON_INCITER_AT_END(buffer, length, i)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[i] != keyword[i]) {
+                return JSON_INCITER_INVALID;
+            }
+        }
+    }
+
+    // Full keyword
+    if (_JSON_INCITER_AT_END(buffer, length, keyword_len) || IS_TERMINATOR(buffer[keyword_len])) {
+        element->tag    = tag;
+        element->length = keyword_len;
+        return JSON_INCITER_OK;
+    } else {
+        return JSON_INCITER_INVALID;
+    }
+}
+
+
+json_inciter_t _json_inciter_parse_value_of_type(const char *buffer, size_t length, _json_inciter_token_t token,
+                                                 json_inciter_continuation_t *continuation,
+                                                 json_inciter_element_t *element) {
+    size_t parsing_index = 0;
+
+    element->flags &= (uint8_t)~_JSON_INCITER_FLAG_UNRESOLVED;
+
+    // Leading whitespace is only skipped once
+    if (!(continuation->state & _JSON_INCITER_SCAN_VALUE)) {
+        continuation->offset +=
+            _json_inciter_skip_whitespace(&buffer[continuation->offset], length - continuation->offset);
+        if (_JSON_INCITER_AT_END(buffer, length, continuation->offset)) {
+            element->start  = &buffer[continuation->offset];
+            element->length = 0;
+            return JSON_INCITER_INCOMPLETE;
+        }
+
+        continuation->value_offset = continuation->offset;
+        continuation->state |= _JSON_INCITER_SCAN_VALUE;
+    }
+    parsing_index    = continuation->value_offset;
+    size_t remaining = _JSON_INCITER_REMAINING(length, parsing_index);
+
+    if (token == _JSON_INCITER_TOKEN_ANY) {
+        token = _json_inciter_get_next_token_type(buffer[parsing_index]);
+    }
+
+    switch (token) {
+        case _JSON_INCITER_TOKEN_KEYWORD: {
+            element->start  = &buffer[parsing_index];
+            element->length = 0;
+            return _json_inciter_parse_literal(&buffer[parsing_index], remaining, element);
         }
 
         case _JSON_INCITER_TOKEN_NUMBER: {
-            const char *endptr = NULL;
+            _json_inciter_number_t number = _JSON_INCITER_ZERO;
 
-            element->start     = &buffer[parsing_index];
-            element->as.number = strtod(&buffer[parsing_index], (char **)&endptr);
+            element->start  = &buffer[parsing_index];
+            element->length = 0;
 
-            // No conversion, invalid number
-            if (endptr == &buffer[parsing_index]) {
-                element->length = 0;
-                return JSON_INCITER_INVALID;
+            json_inciter_t result = _json_inciter_scan_number(&buffer[parsing_index], remaining, &number);
+            if (result != JSON_INCITER_OK) {
+                return result;
             }
-            // Conversion successful
-            else {
-                size_t terminator_index = parsing_index + (endptr - &buffer[parsing_index]);
-                if (IS_TERMINATOR(buffer[terminator_index])) {
-                    element->length = terminator_index - parsing_index;
-                    element->tag    = JSON_INCITER_ELEMENT_TAG_NUMBER;
-                    return JSON_INCITER_OK;
-                } else {
-                    element->length = 0;
-                    return JSON_INCITER_INVALID;
+
+            // Digits running up to the length may go on in the bytes that follow
+            size_t terminator_index = parsing_index + number.length;
+            if (terminator_index >= length && !(continuation->state & _JSON_INCITER_SCAN_FINAL)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (_JSON_INCITER_AT_END(buffer, length, terminator_index) ||
+                       IS_TERMINATOR(buffer[terminator_index])) {
+                // Conversion is left to `json_inciter_element_as_double`
+                if (!(element->flags & JSON_INCITER_FLAG_LAZY_NUMBERS)) {
+                    element->as.number = _json_inciter_number_to_double(&buffer[parsing_index], remaining, &number);
                 }
+                element->length = number.length;
+                element->tag    = JSON_INCITER_ELEMENT_TAG_NUMBER;
+                return JSON_INCITER_OK;
+            } else {
+                return JSON_INCITER_INVALID;
             }
             break;
         }
@@ -336,9 +1340,19 @@ json_inciter_t _json_inciter_parse_value_of_type(const char *buffer, _json_incit
             }
             parsing_index++;
 
-            size_t string_end = parsing_index + _json_inciter_skip_string(&buffer[parsing_index]);
+            // Resume from where the previous scan stopped
+            if (!(continuation->state & _JSON_INCITER_SCAN_STRING)) {
+                continuation->offset = parsing_index;
+                continuation->state |= _JSON_INCITER_SCAN_STRING;
+            }
+
+            size_t string_end = continuation->offset + _json_inciter_skip_string(&buffer[continuation->offset],
+                                                                                 length - continuation->offset,
+                                                                                 &continuation->state);
+            continuation->offset = string_end;
+
             // Valid string
-            if (buffer[string_end] == '"') {
+            if (!_JSON_INCITER_AT_END(buffer, length, string_end) && buffer[string_end] == '"') {
                 element->tag       = JSON_INCITER_ELEMENT_TAG_STRING;
                 element->start     = &buffer[parsing_index - 1];         // Include the quotes
                 element->length    = string_end - parsing_index + 2;     // Include the quotes
@@ -360,16 +1374,26 @@ json_inciter_t _json_inciter_parse_value_of_type(const char *buffer, _json_incit
             if (buffer[parsing_index] != '[') {
                 return JSON_INCITER_INVALID;
             }
+            // The end is left to `json_inciter_element_resolve`, bounded by the rest of the stream
+            else if (element->flags & JSON_INCITER_FLAG_LAZY_CONTAINERS) {
+                element->tag    = JSON_INCITER_ELEMENT_TAG_ARRAY;
+                element->length = remaining;
+                element->flags |= _JSON_INCITER_FLAG_UNRESOLVED;
+                return JSON_INCITER_OK;
+            }
             parsing_index++;
 
-            int terminator_position = _json_inciter_skip_to_terminator(&buffer[parsing_index], ']');
-            if (terminator_position < 0) {
-                return JSON_INCITER_INVALID;
-            } else {
+            // Resume from where the previous scan stopped
+            if (continuation->offset < parsing_index) {
+                continuation->offset = parsing_index;
+            }
+
+            json_inciter_t result = _json_inciter_skip_to_terminator(buffer, length, ']', continuation);
+            if (result == JSON_INCITER_OK) {
                 element->tag    = JSON_INCITER_ELEMENT_TAG_ARRAY;
-                element->length = terminator_position + 2;
-                return JSON_INCITER_OK;
+                element->length = continuation->offset - continuation->value_offset + 1;
             }
+            return result;
             break;
         }
 
@@ -380,16 +1404,26 @@ json_inciter_t _json_inciter_parse_value_of_type(const char *buffer, _json_incit
             if (buffer[parsing_index] != '{') {
                 return JSON_INCITER_INVALID;
             }
+            // The end is left to `json_inciter_element_resolve`, bounded by the rest of the stream
+            else if (element->flags & JSON_INCITER_FLAG_LAZY_CONTAINERS) {
+                element->tag    = JSON_INCITER_ELEMENT_TAG_OBJECT;
+                element->length = remaining;
+                element->flags |= _JSON_INCITER_FLAG_UNRESOLVED;
+                return JSON_INCITER_OK;
+            }
             parsing_index++;
 
-            int terminator_position = _json_inciter_skip_to_terminator(&buffer[parsing_index], '}');
-            if (terminator_position < 0) {
-                return JSON_INCITER_INVALID;
-            } else {
+            // Resume from where the previous scan stopped
+            if (continuation->offset < parsing_index) {
+                continuation->offset = parsing_index;
+            }
+
+            json_inciter_t result = _json_inciter_skip_to_terminator(buffer, length, '}', continuation);
+            if (result == JSON_INCITER_OK) {
                 element->tag    = JSON_INCITER_ELEMENT_TAG_OBJECT;
-                element->length = terminator_position + 2;
-                return JSON_INCITER_OK;
+                element->length = continuation->offset - continuation->value_offset + 1;
             }
+            return result;
             break;
         }
 
@@ -401,66 +1435,176 @@ json_inciter_t _json_inciter_parse_value_of_type(const char *buffer, _json_incit
 }
 
 
+// Count a parse, and the bytes it covered unless the end of the value is left to be resolved
+#ifdef JSON_INCITER_STATS
+void _json_inciter_stats_parsed(const char *buffer, json_inciter_t result, const json_inciter_element_t *element) {
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_PARSE], 1);
+    if (result == JSON_INCITER_OK && !(element->flags & _JSON_INCITER_FLAG_UNRESOLVED)) {
+        _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_PARSE], (size_t)(element->start - buffer) + element->length);
+    } else if (result == JSON_INCITER_INCOMPLETE) {
+        _JSON_INCITER_STATS_ADD(incomplete, 1);
+    }
+}
+#define _JSON_INCITER_STATS_PARSED(Buffer, Result, Element) _json_inciter_stats_parsed(Buffer, Result, Element)
+#else
+#define _JSON_INCITER_STATS_PARSED(Buffer, Result, Element) ((void)0)
+#endif
+
+
+// Parse a value from the start of a bounded buffer, `state` being _JSON_INCITER_SCAN_FINAL when the buffer ends with
+// the document
+json_inciter_t _json_inciter_parse_bounded(const char *buffer, size_t length, uint8_t state,
+                                           json_inciter_element_t *element) {
+    json_inciter_continuation_t continuation = _JSON_INCITER_ZERO;
+    json_inciter_t              result       = JSON_INCITER_OK;
+
+    continuation.state = state;
+    result = _json_inciter_parse_value_of_type(buffer, length, _JSON_INCITER_TOKEN_ANY, &continuation, element);
+    _JSON_INCITER_STATS_PARSED(buffer, result, element);
+    return result;
+}
+
+
 /**
  * Public API
  */
 
 
 /**
- * @brief attempts to parse a jso n buffer
+ * @brief attempts to parse a json buffer of known length, which doesn't need to be NUL terminated. The buffer is
+ * never read past `length` bytes; reaching the end before the element is complete returns JSON_INCITER_INCOMPLETE,
+ * as does a number running up to `length`, since more digits may follow (see `json_inciter_parse_document_n`)
  *
  * @param buffer the json string
+ * @param length the number of bytes available in `buffer`
  * @param element a pointer to the struct to be filled with the parsed element
  *
  * @return result state
  */
-json_inciter_t json_inciter_parse_value(const char *buffer, json_inciter_element_t *element) {
-    return _json_inciter_parse_value_of_type(buffer, _JSON_INCITER_TOKEN_ANY, element);
+json_inciter_t json_inciter_parse_value_n(const char *buffer, size_t length, json_inciter_element_t *element) {
+    return _json_inciter_parse_bounded(buffer, length, 0, element);
 }
 
 
 /**
- * @brief parse a key-value pair
+ * @brief attempts to parse a json buffer of known length that holds the whole document (see
+ * `json_inciter_parse_value_n`). The end of the buffer ends the document, so a number running up to `length` is
+ * complete.
  *
  * @param buffer the json string
- * @param key pointer to a buffer to be filled with the key string
- * @param key_len pointer to an index to be filled with the key string length
+ * @param length the number of bytes in `buffer`
  * @param element a pointer to the struct to be filled with the parsed element
  *
  * @return result state
  */
-json_inciter_t json_inciter_parse_pair(const char *buffer, const char **key, size_t *key_len,
-                                       json_inciter_element_t *element) {
-    size_t parsing_index = _json_inciter_skip_whitespace(buffer);
+json_inciter_t json_inciter_parse_document_n(const char *buffer, size_t length, json_inciter_element_t *element) {
+    return _json_inciter_parse_bounded(buffer, length, _JSON_INCITER_SCAN_FINAL, element);
+}
+
+
+/**
+ * @brief attempts to parse a jso n buffer
+ *
+ * @param buffer the json string
+ * @param element a pointer to the struct to be filled with the parsed element
+ *
+ * @return result state
+ */
+json_inciter_t json_inciter_parse_value(const char *buffer, json_inciter_element_t *element) {
+    return json_inciter_parse_value_n(buffer, _JSON_INCITER_UNBOUNDED, element);
+}
 
-    json_inciter_element_t key_element = {0};
+
+/**
+ * @brief attempts to parse a json buffer that is still being received. When the result is JSON_INCITER_INCOMPLETE
+ * the continuation holds the scanner state; once more bytes have been appended to the same buffer the call can be
+ * repeated and the scan picks up exactly where it stopped, so the total cost stays linear in the bytes received.
+ * The continuation must be zero initialized before the first call and is reset when a result other than
+ * JSON_INCITER_INCOMPLETE is returned.
+ *
+ * @param buffer the json string; must start at the same position on every call
+ * @param length the number of bytes available in `buffer`
+ * @param continuation pointer to the caller owned scanner state
+ * @param element a pointer to the struct to be filled with the parsed element
+ *
+ * @return result state
+ */
+json_inciter_t json_inciter_parse_value_resume_n(const char *buffer, size_t length,
+                                                 json_inciter_continuation_t *continuation,
+                                                 json_inciter_element_t     *element) {
+    _JSON_INCITER_STATS_ADD(resumes, (continuation->state & _JSON_INCITER_SCAN_VALUE) != 0);
 
     json_inciter_t result =
-        _json_inciter_parse_value_of_type(&buffer[parsing_index], _JSON_INCITER_TOKEN_STRING, &key_element);
-    if (result != JSON_INCITER_OK) {
-        return result;
+        _json_inciter_parse_value_of_type(buffer, length, _JSON_INCITER_TOKEN_ANY, continuation, element);
+    _JSON_INCITER_STATS_PARSED(buffer, result, element);
+    if (result != JSON_INCITER_INCOMPLETE) {
+        memset(continuation, 0, sizeof(*continuation));
     }
+    return result;
+}
 
-    if (key_element.tag == JSON_INCITER_ELEMENT_TAG_STRING) {
-        if (key != NULL) {
-            *key = key_element.as.string;
-        }
-        if (key_len != NULL) {
-            *key_len = JSON_INCITER_STRING_LENGTH(key_element);
-        }
-
-        parsing_index += key_element.length;
-        parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index]);
 
-        // Pair
-        if (buffer[parsing_index] == ':') {
-            parsing_index++;
-            return json_inciter_parse_value(&buffer[parsing_index], element);
-        }
+/**
+ * @brief attempts to parse a NUL terminated json buffer that is still being received (see
+ * `json_inciter_parse_value_resume_n`)
+ *
+ * @param buffer the json string; must start at the same position on every call
+ * @param continuation pointer to the caller owned scanner state
+ * @param element a pointer to the struct to be filled with the parsed element
+ *
+ * @return result state
+ */
+json_inciter_t json_inciter_parse_value_resume(const char *buffer, json_inciter_continuation_t *continuation,
+                                               json_inciter_element_t *element) {
+    return json_inciter_parse_value_resume_n(buffer, _JSON_INCITER_UNBOUNDED, continuation, element);
+}
+
+
+/**
+ * @brief parse a key-value pair from a buffer of known length (see `json_inciter_parse_value_n`)
+ *
+ * @param buffer the json string
+ * @param length the number of bytes available in `buffer`
+ * @param key pointer to a buffer to be filled with the key string
+ * @param key_len pointer to an index to be filled with the key string length
+ * @param element a pointer to the struct to be filled with the parsed element
+ *
+ * @return result state
+ */
+json_inciter_t json_inciter_parse_pair_n(const char *buffer, size_t length, const char **key, size_t *key_len,
+                                         json_inciter_element_t *element) {
+    size_t parsing_index = _json_inciter_skip_whitespace(buffer, length);
+
+    json_inciter_element_t      key_element  = _JSON_INCITER_ZERO;
+    json_inciter_continuation_t continuation = _JSON_INCITER_ZERO;
+
+    json_inciter_t result = _json_inciter_parse_value_of_type(&buffer[parsing_index], length - parsing_index,
+                                                              _JSON_INCITER_TOKEN_STRING, &continuation, &key_element);
+    if (result != JSON_INCITER_OK) {
+        return result;
+    }
+
+    if (key_element.tag == JSON_INCITER_ELEMENT_TAG_STRING) {
+        if (key != NULL) {
+            *key = key_element.as.string;
+        }
+        if (key_len != NULL) {
+            *key_len = JSON_INCITER_STRING_LENGTH(key_element);
+        }
+
+        parsing_index += key_element.length;
+        parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+
         // Incomplete
-        else if (buffer[parsing_index] == '\0') {
+        if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
             return JSON_INCITER_INCOMPLETE;
         }
+        // Pair
+        else if (buffer[parsing_index] == ':') {
+            parsing_index++;
+            return json_inciter_parse_value_n(&buffer[parsing_index], _JSON_INCITER_REMAINING(length, parsing_index),
+                                              element);
+        }
         // Invalid
         else {
             return JSON_INCITER_INVALID;
@@ -472,17 +1616,38 @@ json_inciter_t json_inciter_parse_pair(const char *buffer, const char **key, siz
 
 
 /**
- * @brief find the pointer to the next element in the json buffer
+ * @brief parse a key-value pair
+ *
+ * @param buffer the json string
+ * @param key pointer to a buffer to be filled with the key string
+ * @param key_len pointer to an index to be filled with the key string length
+ * @param element a pointer to the struct to be filled with the parsed element
+ *
+ * @return result state
+ */
+json_inciter_t json_inciter_parse_pair(const char *buffer, const char **key, size_t *key_len,
+                                       json_inciter_element_t *element) {
+    return json_inciter_parse_pair_n(buffer, _JSON_INCITER_UNBOUNDED, key, key_len, element);
+}
+
+
+/**
+ * @brief find the pointer to the next element in a json buffer of known length (see `json_inciter_parse_value_n`)
  *
  * @param buffer json
+ * @param length the number of bytes available in `buffer`
  * @param tag JSON_INCITER_ELEMENT_TAG_OBJECT or JSON_INCITER_ELEMENT_TAG_ARRAY
  * @param next_start pointer to be filled with the position of the next element, if any
  *
  * @return result
  */
-json_inciter_t json_inciter_next_element_start(const char *buffer, json_inciter_element_tag_t tag,
-                                               const char **next_start) {
-    size_t parsing_index = _json_inciter_skip_whitespace(buffer);
+json_inciter_t json_inciter_next_element_start_n(const char *buffer, size_t length, json_inciter_element_tag_t tag,
+                                                 const char **next_start) {
+    size_t parsing_index = _json_inciter_skip_whitespace(buffer, length);
+    if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+        return JSON_INCITER_INCOMPLETE;
+    }
+
     switch (buffer[parsing_index]) {
         // Comma, everything as expected
         case ',':
@@ -502,14 +1667,27 @@ json_inciter_t json_inciter_next_element_start(const char *buffer, json_inciter_
             } else {
                 return JSON_INCITER_INVALID;
             }
-        case '\0':
-            return JSON_INCITER_INCOMPLETE;
         default:
             return JSON_INCITER_INVALID;
     }
 }
 
 
+/**
+ * @brief find the pointer to the next element in the json buffer
+ *
+ * @param buffer json
+ * @param tag JSON_INCITER_ELEMENT_TAG_OBJECT or JSON_INCITER_ELEMENT_TAG_ARRAY
+ * @param next_start pointer to be filled with the position of the next element, if any
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_next_element_start(const char *buffer, json_inciter_element_tag_t tag,
+                                               const char **next_start) {
+    return json_inciter_next_element_start_n(buffer, _JSON_INCITER_UNBOUNDED, tag, next_start);
+}
+
+
 /**
  * @brief get a pointer to the beginning of the content of the element
  *
@@ -530,76 +1708,3958 @@ const char *json_inciter_element_content_start(json_inciter_element_t element) {
 
 
 /**
- * @brief Look for a specific key in an object
+ * @brief get the parsing mode of an element, to hand on to the elements parsed below it
  *
- * @param object
- * @param required_key
  * @param element
  *
- * @return result
+ * @return the flags of the element (json_inciter_flag_t), whether or not its end has been resolved
  */
-json_inciter_t json_inciter_find_value_in_object(json_inciter_element_t object, const char *required_key,
-                                                 json_inciter_element_t *element) {
-    json_inciter_t iteration_result = JSON_INCITER_OK;
-    const char    *json_content     = json_inciter_element_content_start(object);
-    size_t         required_key_len = strlen(required_key);
+uint8_t json_inciter_element_flags(json_inciter_element_t element) {
+    return (uint8_t)(element.flags & ~_JSON_INCITER_FLAG_UNRESOLVED);
+}
+
+
+/**
+ * @brief find the end of a container parsed with JSON_INCITER_FLAG_LAZY_CONTAINERS, and cache it in the element.
+ * Any other element is already resolved.
+ *
+ * @param element
+ *
+ * @return JSON_INCITER_OK, or the error found while scanning for the end of the container
+ */
+json_inciter_t json_inciter_element_resolve(json_inciter_element_t *element) {
+    json_inciter_continuation_t scan = _JSON_INCITER_ZERO;
+
+    if (!(element->flags & _JSON_INCITER_FLAG_UNRESOLVED)) {
+        return JSON_INCITER_OK;
+    }
+
+    scan.offset           = 1;
+    json_inciter_t result = _json_inciter_skip_to_terminator(
+        element->start, element->length, element->tag == JSON_INCITER_ELEMENT_TAG_ARRAY ? ']' : '}', &scan);
+    if (result == JSON_INCITER_OK) {
+        element->length = scan.offset + 1;
+        element->flags &= (uint8_t)~_JSON_INCITER_FLAG_UNRESOLVED;
+    }
+    return result;
+}
+
+
+/**
+ * @brief get a pointer to the remaining json, after the element. Unlike `JSON_INCITER_ELEMENT_NEXT_START`, the end
+ * of a container parsed with JSON_INCITER_FLAG_LAZY_CONTAINERS is found at this point and cached in the element.
+ *
+ * @param element
+ *
+ * @return pointer, NULL if the end of a lazy container could not be found
+ */
+const char *json_inciter_element_next_start(json_inciter_element_t *element) {
+    if (json_inciter_element_resolve(element) != JSON_INCITER_OK) {
+        return NULL;
+    }
+    return element->start + element->length;
+}
+
+
+/**
+ * @brief Prepare to iterate over the members of an array or object with `json_inciter_iter_next`
+ *
+ * @param iter the iterator to initialize
+ * @param container the array or object; a lazy container is bounded by the rest of the stream
+ *
+ * @return JSON_INCITER_OK, or JSON_INCITER_INVALID if the element is not a container
+ */
+json_inciter_t json_inciter_iter_init(json_inciter_iter_t *iter, json_inciter_element_t container) {
+    iter->buffer = container.start;
+    iter->length = container.length;
+    iter->offset = 1;
+    iter->tag    = container.tag;
+    iter->state  = _JSON_INCITER_ITER_FIRST;
+
+    if (container.tag != JSON_INCITER_ELEMENT_TAG_ARRAY && container.tag != JSON_INCITER_ELEMENT_TAG_OBJECT) {
+        iter->state = _JSON_INCITER_ITER_DONE;
+        return JSON_INCITER_INVALID;
+    }
+    return JSON_INCITER_OK;
+}
 
-    do {
-        const char            *key      = NULL;
-        size_t                 key_size = 0;
-        json_inciter_element_t value    = {0};
-        json_inciter_t         result   = json_inciter_parse_pair(json_content, &key, &key_size, &value);
 
+/**
+ * @brief Parse the next member of a container: the separator, the key of an object member and its value are read in a
+ * single scan that skips every whitespace run once. Lazy containers are returned unresolved and skipped by the next
+ * call.
+ *
+ * @param iter the iterator
+ * @param key a pointer to the struct to be filled with the key, as a string element; can be NULL, ignored for arrays
+ * @param value a pointer to the struct to be filled with the value (its flags select the parsing mode)
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_DONE past the end of the container, JSON_INCITER_INVALID or
+ * JSON_INCITER_INCOMPLETE, also for a number reaching `iter->length`; the iterator only moves when the result is
+ * JSON_INCITER_OK or JSON_INCITER_DONE
+ */
+json_inciter_t json_inciter_iter_next(json_inciter_iter_t *iter, json_inciter_element_t *key,
+                                      json_inciter_element_t *value) {
+    const char    *buffer        = iter->buffer;
+    size_t         length        = iter->length;
+    size_t         parsing_index = iter->offset;
+    char           closer        = iter->tag == JSON_INCITER_ELEMENT_TAG_ARRAY ? ']' : '}';
+    json_inciter_t result;
+
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_ITER], 1);
+    if (iter->state == _JSON_INCITER_ITER_DONE) {
+        return JSON_INCITER_DONE;
+    }
+    // The lazy container returned last is skipped now, the caller may have left it unresolved
+    else if (iter->state == _JSON_INCITER_ITER_PENDING) {
+        json_inciter_continuation_t scan = _JSON_INCITER_ZERO;
+
+        scan.value_offset = parsing_index;
+        scan.offset       = parsing_index + 1;
+        scan.state        = _JSON_INCITER_SCAN_VALUE;
+        result = _json_inciter_skip_to_terminator(buffer, length, buffer[parsing_index] == '[' ? ']' : '}', &scan);
         if (result != JSON_INCITER_OK) {
             return result;
         }
+        iter->offset  = scan.offset + 1;
+        iter->state   = _JSON_INCITER_ITER_MEMBER;
+        parsing_index = iter->offset;
+    }
 
-        if (key_size == required_key_len && strncmp(required_key, key, required_key_len) == 0) {
-            *element = value;
-            return JSON_INCITER_OK;
+    parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+    if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+        return JSON_INCITER_INCOMPLETE;
+    } else if (buffer[parsing_index] == closer) {
+        _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_ITER], parsing_index + 1 - iter->offset);
+        iter->offset = parsing_index + 1;
+        iter->state  = _JSON_INCITER_ITER_DONE;
+        return JSON_INCITER_DONE;
+    } else if (iter->state == _JSON_INCITER_ITER_MEMBER) {
+        if (buffer[parsing_index] != ',') {
+            return JSON_INCITER_INVALID;
+        }
+        parsing_index++;
+        parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+        if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+            return JSON_INCITER_INCOMPLETE;
         }
+    }
 
-        json_content = JSON_INCITER_ELEMENT_NEXT_START(value);
-        iteration_result =
-            json_inciter_next_element_start(json_content, JSON_INCITER_ELEMENT_TAG_OBJECT, &json_content);
-    } while (iteration_result == JSON_INCITER_OK);
+    // Object keys, followed by a colon
+    if (iter->tag == JSON_INCITER_ELEMENT_TAG_OBJECT) {
+        json_inciter_continuation_t continuation = _JSON_INCITER_ZERO;
+        json_inciter_element_t      key_element  = _JSON_INCITER_ZERO;
 
-    return JSON_INCITER_DONE;
+        result = _json_inciter_parse_value_of_type(&buffer[parsing_index], length - parsing_index,
+                                                   _JSON_INCITER_TOKEN_STRING, &continuation, &key_element);
+        if (result != JSON_INCITER_OK) {
+            return result;
+        }
+
+        parsing_index += key_element.length;
+        parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+        if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+            return JSON_INCITER_INCOMPLETE;
+        } else if (buffer[parsing_index] != ':') {
+            return JSON_INCITER_INVALID;
+        }
+        parsing_index++;
+        parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+        if (key != NULL) {
+            *key = key_element;
+        }
+    }
+
+    result = json_inciter_parse_value_n(&buffer[parsing_index], _JSON_INCITER_REMAINING(length, parsing_index), value);
+    if (result != JSON_INCITER_OK) {
+        return result;
+    }
+
+    if (value->flags & _JSON_INCITER_FLAG_UNRESOLVED) {
+        _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_ITER], parsing_index - iter->offset);
+        iter->offset = parsing_index;
+        iter->state  = _JSON_INCITER_ITER_PENDING;
+    } else {
+        _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_ITER], parsing_index + value->length - iter->offset);
+        iter->offset = parsing_index + value->length;
+        iter->state  = _JSON_INCITER_ITER_MEMBER;
+    }
+    return JSON_INCITER_OK;
 }
 
 
 /**
- * @brief copy the content of the element into a buffer. Useful mostly for strings.
+ * @brief get the value of a number element. Elements parsed with JSON_INCITER_FLAG_LAZY_NUMBERS are converted at
+ * this point; the others just return the value computed while parsing.
  *
- * @param content_buffer the buffer to be filled with the content
- * @param max_len the size of the buffer
  * @param element
+ * @param value pointer to be filled with the number
  *
- * @return 0 if successful (i.e. the buffer size was sufficient to hold the content), -1 otherwise
+ * @return JSON_INCITER_OK, or JSON_INCITER_INVALID if the element is not a number
  */
-uint8_t json_inciter_copy_content(char *content_buffer, size_t max_len, json_inciter_element_t element) {
-    size_t      len   = 0;
-    const char *start = NULL;
-
-    if (element.tag == JSON_INCITER_ELEMENT_TAG_STRING) {
-        len   = JSON_INCITER_STRING_LENGTH(element);
-        start = element.as.string + 1;
+json_inciter_t json_inciter_element_as_double(json_inciter_element_t element, double *value) {
+    if (element.tag != JSON_INCITER_ELEMENT_TAG_NUMBER) {
+        return JSON_INCITER_INVALID;
+    } else if (element.flags & JSON_INCITER_FLAG_LAZY_NUMBERS) {
+        _json_inciter_number_t number = _JSON_INCITER_ZERO;
+        json_inciter_t         result = _json_inciter_scan_number(element.start, element.length, &number);
+        if (result != JSON_INCITER_OK) {
+            return JSON_INCITER_INVALID;
+        }
+        *value = _json_inciter_number_to_double(element.start, element.length, &number);
+        return JSON_INCITER_OK;
     } else {
-        len   = element.length;
-        start = element.start;
+        *value = element.as.number;
+        return JSON_INCITER_OK;
     }
+}
 
-    if (len < max_len - 1) {
-        memcpy(content_buffer, start, len);
-        content_buffer[len] = '\0';
+
+// Value of 4 hexadecimal digits, -1 if any of them is invalid
+int32_t _json_inciter_hex4(const char *digits) {
+    int32_t value = 0;
+
+    for (size_t i = 0; i < 4; i++) {
+        char digit = digits[i];
+        value <<= 4;
+        if (IS_DIGIT(digit)) {
+            value |= digit - '0';
+        } else if (digit >= 'a' && digit <= 'f') {
+            value |= digit - 'a' + 10;
+        } else if (digit >= 'A' && digit <= 'F') {
+            value |= digit - 'A' + 10;
+        } else {
+            return -1;
+        }
+    }
+    return value;
+}
+
+
+// Decode the escape sequence starting with the backslash at `escape` into at most 4 bytes of UTF-8. Surrogate pairs
+// are combined, lone surrogates have no UTF-8 form and become U+FFFD. Returns the number of bytes read, 0 for invalid
+// sequences.
+size_t _json_inciter_decode_escape(const char *escape, size_t length, char *utf8, size_t *utf8_len) {
+    const char *simple  = "\"\\/bfnrt";
+    const char *decoded = "\"\\/\b\f\n\r\t";
+
+    if (length < 2) {
+        return 0;
+    } else if (escape[1] != 'u') {
+        const char *found = escape[1] != '\0' ? strchr(simple, escape[1]) : NULL;
+        if (found == NULL) {
+            return 0;
+        }
+        utf8[0]   = decoded[found - simple];
+        *utf8_len = 1;
+        return 2;
+    }
+
+    int32_t code_point = length >= 6 ? _json_inciter_hex4(&escape[2]) : -1;
+    size_t  consumed   = 6;
+    if (code_point < 0) {
         return 0;
+    }
+
+    if (code_point >= 0xD800 && code_point <= 0xDBFF && length >= 12 && escape[6] == '\\' && escape[7] == 'u') {
+        int32_t low = _json_inciter_hex4(&escape[8]);
+        if (low >= 0xDC00 && low <= 0xDFFF) {
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+            consumed   = 12;
+        }
+    }
+    if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+        code_point = 0xFFFD;
+    }
+
+    if (code_point < 0x80) {
+        utf8[0]   = (char)code_point;
+        *utf8_len = 1;
+    } else if (code_point < 0x800) {
+        utf8[0]   = (char)(0xC0 | (code_point >> 6));
+        utf8[1]   = (char)(0x80 | (code_point & 0x3F));
+        *utf8_len = 2;
+    } else if (code_point < 0x10000) {
+        utf8[0]   = (char)(0xE0 | (code_point >> 12));
+        utf8[1]   = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        utf8[2]   = (char)(0x80 | (code_point & 0x3F));
+        *utf8_len = 3;
     } else {
+        utf8[0]   = (char)(0xF0 | (code_point >> 18));
+        utf8[1]   = (char)(0x80 | ((code_point >> 12) & 0x3F));
+        utf8[2]   = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        utf8[3]   = (char)(0x80 | (code_point & 0x3F));
+        *utf8_len = 4;
+    }
+    return consumed;
+}
+
+
+// Offset of the first backslash in a span of known length, `length` if there is none
+size_t _json_inciter_find_backslash(const char *buffer, size_t length) {
+    size_t index = 0;
+
+#if defined(_JSON_INCITER_SIMD_AVX2)
+    for (; length - index >= 32; index += 32) {
+        __m256i  bytes = _mm256_loadu_si256((const __m256i *)&buffer[index]);
+        uint32_t mask  = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\')));
+        if (mask != 0) {
+            return index + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif
+#if defined(_JSON_INCITER_SIMD_SSE2)
+    for (; length - index >= 16; index += 16) {
+        __m128i  bytes = _mm_loadu_si128((const __m128i *)&buffer[index]);
+        uint32_t mask  = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')));
+        if (mask != 0) {
+            return index + (size_t)__builtin_ctz(mask);
+        }
+    }
+#elif defined(_JSON_INCITER_SIMD_NEON)
+    for (; length - index >= 16; index += 16) {
+        uint8x16_t bytes = vld1q_u8((const uint8_t *)&buffer[index]);
+        uint32_t   mask  = _json_inciter_neon_movemask(vceqq_u8(bytes, vdupq_n_u8('\\')));
+        if (mask != 0) {
+            return index + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif
+
+    while (index < length && buffer[index] != '\\') {
+        index++;
+    }
+    return index;
+}
+
+
+// Decode the content of a json string into `destination`, which can be the content itself as decoding never makes
+// it longer. Only the bytes that fit in `size` are written, but the whole decoded length is reported. Runs without
+// escapes are copied in bulk.
+json_inciter_t _json_inciter_unescape(const char *content, size_t length, char *destination, size_t size,
+                                      size_t *unescaped_len) {
+    size_t read    = 0;
+    size_t written = 0;
+
+    while (read < length) {
+        size_t run = _json_inciter_find_backslash(&content[read], length - read);
+        if (written + run <= size && &destination[written] != &content[read]) {
+            memmove(&destination[written], &content[read], run);
+        }
+        written += run;
+        read += run;
+
+        if (read < length) {
+            char   utf8[4];
+            size_t utf8_len = 0;
+            size_t consumed = _json_inciter_decode_escape(&content[read], length - read, utf8, &utf8_len);
+            if (consumed == 0) {
+                return JSON_INCITER_INVALID;
+            }
+            if (written + utf8_len <= size) {
+                memcpy(&destination[written], utf8, utf8_len);
+            }
+            written += utf8_len;
+            read += consumed;
+        }
+    }
+
+    *unescaped_len = written;
+    return JSON_INCITER_OK;
+}
+
+
+// Byte stream over the unescaped content of a json string (or over plain bytes)
+typedef struct {
+    const char *content;
+    size_t      length;
+    size_t      index;
+    uint8_t     escaped;     // Whether escape sequences have to be decoded
+    char        pending[4];
+    size_t      pending_len;
+    size_t      pending_index;
+} _json_inciter_unescaped_t;
+
+
+// Next byte of the stream, -1 at the end, -2 for invalid escapes
+int _json_inciter_unescaped_next(_json_inciter_unescaped_t *stream) {
+    if (stream->pending_index < stream->pending_len) {
+        return (unsigned char)stream->pending[stream->pending_index++];
+    } else if (stream->index >= stream->length) {
         return -1;
+    } else if (!stream->escaped || stream->content[stream->index] != '\\') {
+        return (unsigned char)stream->content[stream->index++];
+    }
+
+    size_t consumed = _json_inciter_decode_escape(&stream->content[stream->index], stream->length - stream->index,
+                                                  stream->pending, &stream->pending_len);
+    if (consumed == 0) {
+        return -2;
+    }
+    stream->index += consumed;
+    stream->pending_index = 1;
+    return (unsigned char)stream->pending[0];
+}
+
+
+// FNV-1a hash of the unescaped content, JSON_INCITER_INVALID for invalid escapes
+json_inciter_t _json_inciter_key_hash(const char *content, size_t length, uint8_t escaped, uint32_t *hash) {
+    _json_inciter_unescaped_t stream = {content, length, 0, escaped, {0}, 0, 0};
+    int                       byte   = 0;
+
+    *hash = 2166136261u;
+    while ((byte = _json_inciter_unescaped_next(&stream)) >= 0) {
+        *hash = (*hash ^ (uint32_t)byte) * 16777619u;
+    }
+    return byte == -1 ? JSON_INCITER_OK : JSON_INCITER_INVALID;
+}
+
+
+// Compare the unescaped contents of two keys
+uint8_t _json_inciter_keys_equal(const char *first, size_t first_len, uint8_t first_escaped, const char *second,
+                                 size_t second_len, uint8_t second_escaped) {
+    if (!first_escaped && !second_escaped) {
+        return first_len == second_len && memcmp(first, second, first_len) == 0;
+    }
+
+    _json_inciter_unescaped_t first_stream  = {first, first_len, 0, first_escaped, {0}, 0, 0};
+    _json_inciter_unescaped_t second_stream = {second, second_len, 0, second_escaped, {0}, 0, 0};
+    int                       byte          = 0;
+
+    do {
+        byte = _json_inciter_unescaped_next(&first_stream);
+        if (byte != _json_inciter_unescaped_next(&second_stream)) {
+            return 0;
+        }
+    } while (byte >= 0);
+
+    return byte == -1;
+}
+
+
+// First 8 bytes of a key, zero padded
+uint64_t _json_inciter_key_prefix(const char *key, size_t length) {
+    uint64_t prefix = 0;
+    memcpy(&prefix, key, length < sizeof(prefix) ? length : sizeof(prefix));
+    return prefix;
+}
+
+
+// Whether a key found in the json stream is the precompiled key, most mismatches being rejected by the length or the
+// prefix alone
+uint8_t _json_inciter_key_matches(const json_inciter_key_t *key, const char *candidate, size_t candidate_len) {
+    if (candidate_len != key->length || _json_inciter_key_prefix(candidate, candidate_len) != key->prefix) {
+        return 0;
     }
+    return candidate_len <= sizeof(key->prefix) ||
+           memcmp(&candidate[sizeof(key->prefix)], &key->key[sizeof(key->prefix)],
+                  candidate_len - sizeof(key->prefix)) == 0;
+}
+
+
+// Key for a one-off search, leaving out the hash that only key indexes need
+json_inciter_key_t _json_inciter_key_make_unhashed(const char *key, size_t length) {
+    json_inciter_key_t compiled = {key, length, _json_inciter_key_prefix(key, length), 0};
+    return compiled;
+}
+
+
+/**
+ * @brief Precompile a key of known length (see `JSON_INCITER_KEY` for string literals)
+ *
+ * @param key
+ * @param length
+ *
+ * @return the precompiled key, which points to `key`
+ */
+json_inciter_key_t json_inciter_key_make_n(const char *key, size_t length) {
+    json_inciter_key_t compiled = _json_inciter_key_make_unhashed(key, length);
+    _json_inciter_key_hash(key, length, 0, &compiled.hash);
+    return compiled;
+}
+
+
+/**
+ * @brief Precompile a NUL terminated key
+ *
+ * @param key
+ *
+ * @return the precompiled key, which points to `key`
+ */
+json_inciter_key_t json_inciter_key_make(const char *key) {
+    return json_inciter_key_make_n(key, strlen(key));
 }
 
 
+// Hand a value found by a key search to the caller in the parsing mode `flags` of the object it was found in,
+// converting numbers and resolving containers unless that mode is lazy. The destination is only written.
+json_inciter_t _json_inciter_store_found_value(json_inciter_element_t value, uint8_t flags,
+                                               json_inciter_element_t *element) {
+    if (value.tag == JSON_INCITER_ELEMENT_TAG_NUMBER && !(flags & JSON_INCITER_FLAG_LAZY_NUMBERS)) {
+        json_inciter_element_as_double(value, &value.as.number);
+    } else if (!(flags & JSON_INCITER_FLAG_LAZY_CONTAINERS)) {
+        json_inciter_t result = json_inciter_element_resolve(&value);
+        if (result != JSON_INCITER_OK) {
+            return result;
+        }
+    }
+    value.flags = (uint8_t)(flags | (value.flags & _JSON_INCITER_FLAG_UNRESOLVED));
+    *element    = value;
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Look for a precompiled key in an object. The search never reads past the object's span, and the value found
+ * is returned in the parsing mode of the object (its lazy flags).
+ *
+ * @param object
+ * @param required_key
+ * @param element
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_find_key_in_object(json_inciter_element_t object, const json_inciter_key_t *required_key,
+                                               json_inciter_element_t *element) {
+    json_inciter_iter_t    iter;
+    json_inciter_element_t key   = _JSON_INCITER_ZERO;
+    json_inciter_element_t value = _JSON_INCITER_ZERO;
+    json_inciter_t         result;
+
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_FIND], 1);
+    if (object.tag != JSON_INCITER_ELEMENT_TAG_OBJECT) {
+        return JSON_INCITER_INVALID;
+    }
+    json_inciter_iter_init(&iter, object);
+
+    // Numbers are only converted, and containers only resolved, if their key matches
+    value.flags = JSON_INCITER_FLAG_LAZY_NUMBERS | JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    while ((result = json_inciter_iter_next(&iter, &key, &value)) == JSON_INCITER_OK) {
+        if (_json_inciter_key_matches(required_key, key.as.string, JSON_INCITER_STRING_LENGTH(key))) {
+            _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_FIND], iter.offset);
+            return _json_inciter_store_found_value(value, json_inciter_element_flags(object), element);
+        }
+    }
+
+    // JSON_INCITER_DONE at the end of the object, the error found otherwise
+    _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_FIND], iter.offset);
+    return result;
+}
+
+
+/**
+ * @brief Look for a specific key, of known length, in an object. The search never reads past the object's span.
+ *
+ * @param object
+ * @param required_key
+ * @param required_key_len
+ * @param element
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_find_value_in_object_n(json_inciter_element_t object, const char *required_key,
+                                                   size_t required_key_len, json_inciter_element_t *element) {
+    json_inciter_key_t key = _json_inciter_key_make_unhashed(required_key, required_key_len);
+    return json_inciter_find_key_in_object(object, &key, element);
+}
+
+
+/**
+ * @brief Look for a specific key in an object
+ *
+ * @param object
+ * @param required_key
+ * @param element
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_find_value_in_object(json_inciter_element_t object, const char *required_key,
+                                                 json_inciter_element_t *element) {
+    return json_inciter_find_value_in_object_n(object, required_key, strlen(required_key), element);
+}
+
+
+/**
+ * @brief Look for several precompiled keys in an object, walking its members only once (see
+ * `json_inciter_find_values_in_object`)
+ *
+ * @param object
+ * @param keys array of `n_keys` precompiled keys
+ * @param n_keys number of keys, at most JSON_INCITER_MAX_KEYS
+ * @param elements array of `n_keys` elements, filled for every key found, in the parsing mode of the object
+ * @param found_mask pointer to be filled with the keys found, bit `i` standing for `keys[i]`; can be NULL
+ *
+ * @return JSON_INCITER_OK if every key was found, JSON_INCITER_DONE if the object ended first, the parsing error
+ * otherwise
+ */
+json_inciter_t json_inciter_find_keys_in_object(json_inciter_element_t object, const json_inciter_key_t *keys,
+                                                size_t n_keys, json_inciter_element_t *elements,
+                                                uint32_t *found_mask) {
+    json_inciter_iter_t    iter;
+    json_inciter_element_t key       = _JSON_INCITER_ZERO;
+    json_inciter_element_t value     = _JSON_INCITER_ZERO;
+    json_inciter_t         result    = JSON_INCITER_OK;
+    uint32_t               found     = 0;
+    uint32_t               all_found = 0;
+
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_FIND], 1);
+    if (found_mask != NULL) {
+        *found_mask = 0;
+    }
+    if (n_keys > JSON_INCITER_MAX_KEYS || object.tag != JSON_INCITER_ELEMENT_TAG_OBJECT) {
+        return JSON_INCITER_INVALID;
+    }
+
+    for (size_t i = 0; i < n_keys; i++) {
+        all_found |= (uint32_t)1 << i;
+    }
+    json_inciter_iter_init(&iter, object);
+
+    // Numbers are only converted, and containers only resolved, if their key matches
+    value.flags = JSON_INCITER_FLAG_LAZY_NUMBERS | JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    while (found != all_found && (result = json_inciter_iter_next(&iter, &key, &value)) == JSON_INCITER_OK) {
+        for (size_t i = 0; i < n_keys; i++) {
+            if (!(found & ((uint32_t)1 << i)) &&
+                _json_inciter_key_matches(&keys[i], key.as.string, JSON_INCITER_STRING_LENGTH(key))) {
+                result = _json_inciter_store_found_value(value, json_inciter_element_flags(object), &elements[i]);
+                if (result != JSON_INCITER_OK) {
+                    return result;
+                }
+                found |= (uint32_t)1 << i;
+                if (found_mask != NULL) {
+                    *found_mask = found;
+                }
+                break;
+            }
+        }
+    }
+
+    _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_FIND], iter.offset);
+    if (result != JSON_INCITER_OK && result != JSON_INCITER_DONE) {
+        return result;
+    }
+    return found == all_found ? JSON_INCITER_OK : JSON_INCITER_DONE;
+}
+
+
+/**
+ * @brief Look for several keys in an object, walking its members only once. Each key is matched at its first
+ * occurrence and the walk stops as soon as all of them have been found.
+ *
+ * @param object
+ * @param keys array of `n_keys` keys
+ * @param n_keys number of keys, at most JSON_INCITER_MAX_KEYS
+ * @param elements array of `n_keys` elements, filled for every key found, in the parsing mode of the object
+ * @param found_mask pointer to be filled with the keys found, bit `i` standing for `keys[i]`; can be NULL
+ *
+ * @return JSON_INCITER_OK if every key was found, JSON_INCITER_DONE if the object ended first, the parsing error
+ * otherwise
+ */
+json_inciter_t json_inciter_find_values_in_object(json_inciter_element_t object, const char *const *keys,
+                                                  size_t n_keys, json_inciter_element_t *elements,
+                                                  uint32_t *found_mask) {
+    json_inciter_key_t compiled[JSON_INCITER_MAX_KEYS];
+
+    if (n_keys > JSON_INCITER_MAX_KEYS) {
+        if (found_mask != NULL) {
+            *found_mask = 0;
+        }
+        return JSON_INCITER_INVALID;
+    }
+
+    for (size_t i = 0; i < n_keys; i++) {
+        compiled[i] = _json_inciter_key_make_unhashed(keys[i], strlen(keys[i]));
+    }
+    return json_inciter_find_keys_in_object(object, compiled, n_keys, elements, found_mask);
+}
+
+
+// Compare a reference token of a json pointer, where `~0` stands for `~` and `~1` for `/`, with an object key
+uint8_t _json_inciter_pointer_token_equals(const char *token, size_t token_len, const char *key, size_t key_len) {
+    size_t key_index = 0;
+
+    for (size_t i = 0; i < token_len; i++, key_index++) {
+        char token_char = token[i];
+        if (token_char == '~') {
+            token_char = token[++i] == '0' ? '~' : '/';
+        }
+        if (key_index >= key_len || key[key_index] != token_char) {
+            return 0;
+        }
+    }
+
+    return key_index == key_len;
+}
+
+
+// Split the next reference token off a json pointer. Returns JSON_INCITER_DONE once the pointer is exhausted and
+// JSON_INCITER_INVALID for malformed pointers or escapes.
+json_inciter_t _json_inciter_pointer_next_token(const char **path, const char **token, size_t *token_len) {
+    if ((*path)[0] == '\0') {
+        return JSON_INCITER_DONE;
+    } else if ((*path)[0] != '/') {
+        return JSON_INCITER_INVALID;
+    }
+
+    *token     = &(*path)[1];
+    *token_len = strcspn(*token, "/");
+    *path      = &(*token)[*token_len];
+
+    for (size_t i = 0; i < *token_len; i++) {
+        if ((*token)[i] == '~' && (i + 1 >= *token_len || ((*token)[i + 1] != '0' && (*token)[i + 1] != '1'))) {
+            return JSON_INCITER_INVALID;
+        }
+    }
+    return JSON_INCITER_OK;
+}
+
+
+// Read a reference token as an array index, a decimal number without leading zeroes
+uint8_t _json_inciter_pointer_index(const char *token, size_t token_len, size_t *index) {
+    *index = 0;
+
+    if (token_len == 0 || (token[0] == '0' && token_len > 1)) {
+        return 0;
+    }
+    for (size_t i = 0; i < token_len; i++) {
+        if (!IS_DIGIT(token[i]) || *index > (SIZE_MAX - 9) / 10) {
+            return 0;
+        }
+        *index = *index * 10 + (size_t)(token[i] - '0');
+    }
+    return 1;
+}
+
+
+/**
+ * @brief Resolve a json pointer (RFC 6901), such as "/a/b/0/c", in a buffer of known length. Containers along the
+ * path are entered directly instead of being scanned first; only the siblings that do not match are skipped.
+ *
+ * @param buffer the json string
+ * @param length the number of bytes available in `buffer`
+ * @param path json pointer; the empty string refers to the whole document
+ * @param element a pointer to the struct to be filled with the element found
+ *
+ * @return JSON_INCITER_OK if found, JSON_INCITER_DONE if the path does not exist, JSON_INCITER_INVALID for invalid
+ * json or pointers, JSON_INCITER_INCOMPLETE if the stream ends first
+ */
+json_inciter_t json_inciter_find_path_n(const char *buffer, size_t length, const char *path,
+                                        json_inciter_element_t *element) {
+    size_t         parsing_index = _json_inciter_skip_whitespace(buffer, length);
+    const char    *token         = NULL;
+    size_t         token_len     = 0;
+    json_inciter_t path_result;
+
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_PATH], 1);
+    while ((path_result = _json_inciter_pointer_next_token(&path, &token, &token_len)) == JSON_INCITER_OK) {
+        if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+            return JSON_INCITER_INCOMPLETE;
+        }
+
+        json_inciter_element_tag_t tag         = JSON_INCITER_ELEMENT_TAG_NULL;
+        size_t                     array_index = 0;
+
+        if (buffer[parsing_index] == '{') {
+            tag = JSON_INCITER_ELEMENT_TAG_OBJECT;
+        } else if (buffer[parsing_index] == '[') {
+            tag = JSON_INCITER_ELEMENT_TAG_ARRAY;
+            if (!_json_inciter_pointer_index(token, token_len, &array_index)) {
+                return JSON_INCITER_DONE;
+            }
+        }
+        // Scalars have no children
+        else {
+            return JSON_INCITER_DONE;
+        }
+        parsing_index++;
+
+        // Walk the members, stopping at the start of the matching value
+        for (size_t member = 0;; member++) {
+            json_inciter_element_t value = _JSON_INCITER_ZERO;
+            json_inciter_t         result;
+
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+            if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[parsing_index] == (tag == JSON_INCITER_ELEMENT_TAG_OBJECT ? '}' : ']')) {
+                return JSON_INCITER_DONE;
+            }
+
+            if (tag == JSON_INCITER_ELEMENT_TAG_OBJECT) {
+                json_inciter_element_t      key          = _JSON_INCITER_ZERO;
+                json_inciter_continuation_t continuation = _JSON_INCITER_ZERO;
+
+                result = _json_inciter_parse_value_of_type(&buffer[parsing_index], length - parsing_index,
+                                                           _JSON_INCITER_TOKEN_STRING, &continuation, &key);
+                if (result != JSON_INCITER_OK) {
+                    return result;
+                }
+                parsing_index += (size_t)(JSON_INCITER_ELEMENT_NEXT_START(key) - &buffer[parsing_index]);
+                parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+                if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                    return JSON_INCITER_INCOMPLETE;
+                } else if (buffer[parsing_index] != ':') {
+                    return JSON_INCITER_INVALID;
+                }
+                parsing_index++;
+                parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+
+                if (_json_inciter_pointer_token_equals(token, token_len, key.as.string,
+                                                       JSON_INCITER_STRING_LENGTH(key))) {
+                    break;
+                }
+            } else if (member == array_index) {
+                break;
+            }
+
+            // Not the one: skip the value and move to the next member
+            value.flags = JSON_INCITER_FLAG_LAZY_NUMBERS;
+            result      = json_inciter_parse_value_n(&buffer[parsing_index],
+                                                     _JSON_INCITER_REMAINING(length, parsing_index), &value);
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+
+            const char *next_start = NULL;
+            const char *value_end  = JSON_INCITER_ELEMENT_NEXT_START(value);
+            result                 = json_inciter_next_element_start_n(
+                value_end, _JSON_INCITER_REMAINING(length, (size_t)(value_end - buffer)), tag, &next_start);
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+            parsing_index = (size_t)(next_start - buffer);
+        }
+    }
+    if (path_result != JSON_INCITER_DONE) {
+        return path_result;
+    }
+
+    _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_PATH], parsing_index);
+    return json_inciter_parse_value_n(&buffer[parsing_index], _JSON_INCITER_REMAINING(length, parsing_index),
+                                      element);
+}
+
+
+/**
+ * @brief Resolve a json pointer (RFC 6901) in a NUL terminated buffer (see `json_inciter_find_path_n`)
+ *
+ * @param buffer the json string
+ * @param path json pointer; the empty string refers to the whole document
+ * @param element a pointer to the struct to be filled with the element found
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_find_path(const char *buffer, const char *path, json_inciter_element_t *element) {
+    return json_inciter_find_path_n(buffer, _JSON_INCITER_UNBOUNDED, path, element);
+}
+
+
+// Validate a string, from its opening quote at `*index`, leaving `*index` past its closing quote. Runs of plain
+// ASCII are checked a vector at a time.
+json_inciter_t _json_inciter_validate_string(const char *buffer, size_t length, size_t *index) {
+    size_t i = *index + 1;
+
+    for (;;) {
+#if defined(_JSON_INCITER_SIMD)
+        // Aligned loads never cross a page, so they are safe on NUL terminated buffers
+        if (((uintptr_t)&buffer[i] % 16) == 0) {
+            while (length - i >= 16 && _json_inciter_validate_mask16(&buffer[i]) == 0) {
+                i += 16;
+            }
+        }
+#endif
+        if (_JSON_INCITER_AT_END(buffer, length, i)) {
+            return JSON_INCITER_INCOMPLETE;
+        }
+
+        unsigned char current = (unsigned char)buffer[i];
+        if (current == '"') {
+            *index = i + 1;
+            return JSON_INCITER_OK;
+        } else if (current < 0x20) {
+            return JSON_INCITER_INVALID;
+        } else if (current == '\\') {
+            size_t escape_len = 2;
+            if (_JSON_INCITER_AT_END(buffer, length, i + 1)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[i + 1] == 'u') {
+                for (escape_len = 2; escape_len < 6; escape_len++) {
+                    if (_JSON_INCITER_AT_END(buffer, length, i + escape_len)) {
+                        return JSON_INCITER_INCOMPLETE;
+                    }
+                    char digit = buffer[i + escape_len];
+                    if (!IS_DIGIT(digit) && !((digit | 0x20) >= 'a' && (digit | 0x20) <= 'f')) {
+                        return JSON_INCITER_INVALID;
+                    }
+                }
+            } else if (strchr("\"\\/bfnrt", buffer[i + 1]) == NULL) {
+                return JSON_INCITER_INVALID;
+            }
+            i += escape_len;
+        } else if (current < 0x80) {
+            i++;
+        }
+        // UTF-8 (RFC 3629): no overlong forms, no surrogates, nothing past U+10FFFF
+        else {
+            unsigned char low             = 0x80;
+            unsigned char high            = 0xBF;
+            size_t        continuation_len = 0;
+
+            if (current >= 0xC2 && current <= 0xDF) {
+                continuation_len = 1;
+            } else if (current >= 0xE0 && current <= 0xEF) {
+                continuation_len = 2;
+                low              = current == 0xE0 ? 0xA0 : 0x80;
+                high             = current == 0xED ? 0x9F : 0xBF;
+            } else if (current >= 0xF0 && current <= 0xF4) {
+                continuation_len = 3;
+                low              = current == 0xF0 ? 0x90 : 0x80;
+                high             = current == 0xF4 ? 0x8F : 0xBF;
+            } else {
+                return JSON_INCITER_INVALID;
+            }
+
+            for (size_t j = 1; j <= continuation_len; j++) {
+                if (_JSON_INCITER_AT_END(buffer, length, i + j)) {
+                    return JSON_INCITER_INCOMPLETE;
+                }
+                unsigned char continuation = (unsigned char)buffer[i + j];
+                if (continuation < low || continuation > high) {
+                    return JSON_INCITER_INVALID;
+                }
+                low  = 0x80;
+                high = 0xBF;
+            }
+            i += continuation_len + 1;
+        }
+    }
+}
+
+
+/**
+ * @brief Validate a whole json document (RFC 8259) of known length in a single pass: nesting, strings (escape
+ * sequences and UTF-8), numbers and literals, with nothing but whitespace after the top level value. Validated buffers
+ * can then be read with the `_trusted` functions.
+ *
+ * @param buffer the json string
+ * @param length the number of bytes available in `buffer`
+ *
+ * @return JSON_INCITER_OK for valid json, JSON_INCITER_INVALID, JSON_INCITER_INCOMPLETE if the stream ends first, or
+ * JSON_INCITER_OVERFLOW if it is nested deeper than JSON_INCITER_MAX_DEPTH
+ */
+json_inciter_t json_inciter_validate_n(const char *buffer, size_t length) {
+    uint8_t        objects[(JSON_INCITER_MAX_DEPTH + 7) / 8];     // One bit per open container, set for objects
+    size_t         depth         = 0;
+    size_t         parsing_index = 0;
+    uint8_t        expect_key    = 0;
+    json_inciter_t result;
+
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_VALIDATE], 1);
+    for (;;) {
+        parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+        if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+            return JSON_INCITER_INCOMPLETE;
+        }
+
+        // Object keys, followed by a colon
+        if (expect_key) {
+            if (buffer[parsing_index] != '"') {
+                return JSON_INCITER_INVALID;
+            }
+            result = _json_inciter_validate_string(buffer, length, &parsing_index);
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+            if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[parsing_index] != ':') {
+                return JSON_INCITER_INVALID;
+            }
+            parsing_index++;
+            expect_key = 0;
+            continue;
+        }
+
+        switch (_json_inciter_get_next_token_type(buffer[parsing_index])) {
+            case _JSON_INCITER_TOKEN_ARRAY:
+            case _JSON_INCITER_TOKEN_OBJECT: {
+                uint8_t is_object = buffer[parsing_index] == '{';
+
+                if (depth == JSON_INCITER_MAX_DEPTH) {
+                    return JSON_INCITER_OVERFLOW;
+                }
+                objects[depth / 8] &= (uint8_t)~(1u << (depth % 8));
+                objects[depth / 8] |= (uint8_t)(is_object << (depth % 8));
+                depth++;
+                parsing_index++;
+
+                parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+                if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                    return JSON_INCITER_INCOMPLETE;
+                } else if (buffer[parsing_index] != (is_object ? '}' : ']')) {
+                    expect_key = is_object;
+                    continue;
+                }
+                break;
+            }
+
+            case _JSON_INCITER_TOKEN_STRING:
+                result = _json_inciter_validate_string(buffer, length, &parsing_index);
+                if (result != JSON_INCITER_OK) {
+                    return result;
+                }
+                break;
+
+            case _JSON_INCITER_TOKEN_NUMBER: {
+                _json_inciter_number_t number = _JSON_INCITER_ZERO;
+
+                result = _json_inciter_scan_number(&buffer[parsing_index],
+                                                   _JSON_INCITER_REMAINING(length, parsing_index), &number);
+                if (result != JSON_INCITER_OK) {
+                    return result;
+                }
+                parsing_index += number.length;
+                if (!_JSON_INCITER_AT_END(buffer, length, parsing_index) && !IS_TERMINATOR(buffer[parsing_index])) {
+                    return JSON_INCITER_INVALID;
+                }
+                break;
+            }
+
+            case _JSON_INCITER_TOKEN_KEYWORD: {
+                json_inciter_element_t element = _JSON_INCITER_ZERO;
+
+                result = _json_inciter_parse_literal(&buffer[parsing_index],
+                                                     _JSON_INCITER_REMAINING(length, parsing_index), &element);
+                if (result != JSON_INCITER_OK) {
+                    return result;
+                }
+                parsing_index += element.length;
+                break;
+            }
+
+            default:
+                return JSON_INCITER_INVALID;
+        }
+
+        // After a value: close containers until a comma, or the end of the document, is found
+        for (;;) {
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+            if (depth == 0) {
+                _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_VALIDATE], parsing_index);
+                return _JSON_INCITER_AT_END(buffer, length, parsing_index) ? JSON_INCITER_OK : JSON_INCITER_INVALID;
+            }
+
+            uint8_t is_object = (objects[(depth - 1) / 8] >> ((depth - 1) % 8)) & 1;
+            if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[parsing_index] == ',') {
+                parsing_index++;
+                expect_key = is_object;
+                break;
+            } else if (buffer[parsing_index] != (is_object ? '}' : ']')) {
+                return JSON_INCITER_INVALID;
+            }
+            parsing_index++;
+            depth--;
+        }
+    }
+}
+
+
+/**
+ * @brief Validate a whole NUL terminated json document (see `json_inciter_validate_n`)
+ *
+ * @param buffer the json string
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_validate(const char *buffer) {
+    return json_inciter_validate_n(buffer, _JSON_INCITER_UNBOUNDED);
+}
+
+
+/**
+ * @brief parse a value of a buffer that passed `json_inciter_validate_n`, skipping the checks that validation made
+ * redundant: literals are not compared, lazy numbers are only measured and no bound is enforced. The value must be
+ * followed by a terminator (as values within containers are) or a NUL character.
+ *
+ * @param buffer validated json
+ * @param element a pointer to the struct to be filled with the parsed element (its flags select the parsing mode)
+ *
+ * @return JSON_INCITER_OK, or JSON_INCITER_DONE at the end of a container (or of the buffer), leaving the element
+ * untouched
+ */
+json_inciter_t json_inciter_parse_value_trusted(const char *buffer, json_inciter_element_t *element) {
+    const char *start = &buffer[_json_inciter_skip_whitespace(buffer, _JSON_INCITER_UNBOUNDED)];
+    size_t      index = 1;
+
+    // Closing brackets and NUL characters fall in the keyword class
+    if (*start == ']' || *start == '}' || *start == '\0') {
+        return JSON_INCITER_DONE;
+    }
+
+    element->start = start;
+    element->flags &= (uint8_t)~_JSON_INCITER_FLAG_UNRESOLVED;
+
+    switch (_json_inciter_get_next_token_type(*start)) {
+        case _JSON_INCITER_TOKEN_NUMBER:
+            element->tag = JSON_INCITER_ELEMENT_TAG_NUMBER;
+            if (element->flags & JSON_INCITER_FLAG_LAZY_NUMBERS) {
+                while (!IS_TERMINATOR(start[index]) && start[index] != '\0') {
+                    index++;
+                }
+                element->length = index;
+            } else {
+                _json_inciter_number_t number = _JSON_INCITER_ZERO;
+                _json_inciter_scan_number(start, _JSON_INCITER_UNBOUNDED, &number);
+                element->length    = number.length;
+                element->as.number = _json_inciter_number_to_double(start, _JSON_INCITER_UNBOUNDED, &number);
+            }
+            return JSON_INCITER_OK;
+
+        case _JSON_INCITER_TOKEN_STRING: {
+            uint8_t state = 0;
+
+            index += _json_inciter_skip_string(&start[1], _JSON_INCITER_UNBOUNDED, &state);
+            element->tag       = JSON_INCITER_ELEMENT_TAG_STRING;
+            element->length    = index + 1;
+            element->as.string = &start[1];
+            return JSON_INCITER_OK;
+        }
+
+        case _JSON_INCITER_TOKEN_ARRAY:
+        case _JSON_INCITER_TOKEN_OBJECT:
+            element->tag = *start == '[' ? JSON_INCITER_ELEMENT_TAG_ARRAY : JSON_INCITER_ELEMENT_TAG_OBJECT;
+            element->length = _JSON_INCITER_UNBOUNDED;
+            element->flags |= _JSON_INCITER_FLAG_UNRESOLVED;
+            if (!(element->flags & JSON_INCITER_FLAG_LAZY_CONTAINERS)) {
+                json_inciter_element_resolve(element);
+            }
+            return JSON_INCITER_OK;
+
+        // Keywords, all that is left of validated json
+        default:
+            element->tag    = *start == 't'   ? JSON_INCITER_ELEMENT_TAG_TRUE
+                              : *start == 'f' ? JSON_INCITER_ELEMENT_TAG_FALSE
+                                              : JSON_INCITER_ELEMENT_TAG_NULL;
+            element->length = *start == 'f' ? 5 : 4;
+            return JSON_INCITER_OK;
+    }
+}
+
+
+/**
+ * @brief find the pointer to the next element in a validated buffer (see `json_inciter_next_element_start`)
+ *
+ * @param buffer validated json, after an element
+ * @param next_start pointer to be filled with the position of the next element, if any
+ *
+ * @return JSON_INCITER_OK, or JSON_INCITER_DONE at the end of the container
+ */
+json_inciter_t json_inciter_next_element_start_trusted(const char *buffer, const char **next_start) {
+    buffer += _json_inciter_skip_whitespace(buffer, _JSON_INCITER_UNBOUNDED);
+    if (*buffer != ',') {
+        return JSON_INCITER_DONE;
+    }
+    *next_start = buffer + 1;
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Parse the next member of a container of a validated buffer (see `json_inciter_iter_next`), without checking
+ * separators nor bounds
+ *
+ * @param iter the iterator, set up by `json_inciter_iter_init` on a container of validated json
+ * @param key a pointer to the struct to be filled with the key, as a string element; can be NULL, ignored for arrays
+ * @param value a pointer to the struct to be filled with the value (its flags select the parsing mode)
+ *
+ * @return JSON_INCITER_OK, or JSON_INCITER_DONE past the end of the container
+ */
+json_inciter_t json_inciter_iter_next_trusted(json_inciter_iter_t *iter, json_inciter_element_t *key,
+                                              json_inciter_element_t *value) {
+    const char *current = &iter->buffer[iter->offset];
+
+    if (iter->state == _JSON_INCITER_ITER_DONE) {
+        return JSON_INCITER_DONE;
+    }
+    // The lazy container returned last is skipped now, the caller may have left it unresolved
+    else if (iter->state == _JSON_INCITER_ITER_PENDING) {
+        json_inciter_continuation_t scan = _JSON_INCITER_ZERO;
+
+        scan.offset = 1;
+        _json_inciter_skip_to_terminator(current, _JSON_INCITER_UNBOUNDED, *current == '[' ? ']' : '}', &scan);
+        current += scan.offset + 1;
+    }
+
+    current += _json_inciter_skip_whitespace(current, _JSON_INCITER_UNBOUNDED);
+    if (*current == ',') {
+        current++;
+        current += _json_inciter_skip_whitespace(current, _JSON_INCITER_UNBOUNDED);
+    } else if (*current == ']' || *current == '}') {
+        iter->offset = (size_t)(current + 1 - iter->buffer);
+        iter->state  = _JSON_INCITER_ITER_DONE;
+        return JSON_INCITER_DONE;
+    }
+
+    // Object keys, followed by a colon
+    if (iter->tag == JSON_INCITER_ELEMENT_TAG_OBJECT) {
+        json_inciter_element_t key_element = _JSON_INCITER_ZERO;
+
+        json_inciter_parse_value_trusted(current, &key_element);
+        current = key_element.start + key_element.length;
+        current += _json_inciter_skip_whitespace(current, _JSON_INCITER_UNBOUNDED) + 1;
+        if (key != NULL) {
+            *key = key_element;
+        }
+    }
+
+    json_inciter_parse_value_trusted(current, value);
+    if (value->flags & _JSON_INCITER_FLAG_UNRESOLVED) {
+        iter->offset = (size_t)(value->start - iter->buffer);
+        iter->state  = _JSON_INCITER_ITER_PENDING;
+    } else {
+        iter->offset = (size_t)(value->start + value->length - iter->buffer);
+        iter->state  = _JSON_INCITER_ITER_MEMBER;
+    }
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Look for a precompiled key in an object of a validated buffer (see `json_inciter_find_key_in_object`)
+ *
+ * @param object an object of validated json
+ * @param required_key
+ * @param element
+ *
+ * @return JSON_INCITER_OK if found, JSON_INCITER_DONE otherwise
+ */
+json_inciter_t json_inciter_find_key_in_object_trusted(json_inciter_element_t    object,
+                                                       const json_inciter_key_t *required_key,
+                                                       json_inciter_element_t   *element) {
+    const char *json_content = json_inciter_element_content_start(object);
+
+    json_content += _json_inciter_skip_whitespace(json_content, _JSON_INCITER_UNBOUNDED);
+    if (*json_content == '}') {
+        return JSON_INCITER_DONE;
+    }
+
+    do {
+        json_inciter_element_t value     = _JSON_INCITER_ZERO;
+        uint8_t                state     = 0;
+        const char            *key       = &json_content[_json_inciter_skip_whitespace(json_content,
+                                                                                        _JSON_INCITER_UNBOUNDED) + 1];
+        size_t                 key_size  = _json_inciter_skip_string(key, _JSON_INCITER_UNBOUNDED, &state);
+        const char            *separator = &key[key_size + 1];
+
+        separator += _json_inciter_skip_whitespace(separator, _JSON_INCITER_UNBOUNDED);
+
+        // Numbers are only converted, and containers only resolved, if their key matches
+        value.flags = JSON_INCITER_FLAG_LAZY_NUMBERS | JSON_INCITER_FLAG_LAZY_CONTAINERS;
+        json_inciter_parse_value_trusted(separator + 1, &value);
+
+        if (_json_inciter_key_matches(required_key, key, key_size)) {
+            return _json_inciter_store_found_value(value, json_inciter_element_flags(object), element);
+        }
+        json_content = json_inciter_element_next_start(&value);
+    } while (json_inciter_next_element_start_trusted(json_content, &json_content) == JSON_INCITER_OK);
+
+    return JSON_INCITER_DONE;
+}
+
+
+/**
+ * @brief Look for a specific key in an object of a validated buffer
+ *
+ * @param object an object of validated json
+ * @param required_key
+ * @param element
+ *
+ * @return JSON_INCITER_OK if found, JSON_INCITER_DONE otherwise
+ */
+json_inciter_t json_inciter_find_value_in_object_trusted(json_inciter_element_t object, const char *required_key,
+                                                         json_inciter_element_t *element) {
+    json_inciter_key_t key = _json_inciter_key_make_unhashed(required_key, strlen(required_key));
+    return json_inciter_find_key_in_object_trusted(object, &key, element);
+}
+
+
+/**
+ * @brief Prepare to iterate over the records of a newline delimited json buffer. Blank lines are skipped and lines may
+ * end with `\r\n`.
+ *
+ * @param records the cursor to initialize
+ * @param buffer the records
+ * @param length the number of bytes available in `buffer`
+ */
+void json_inciter_records_init_n(json_inciter_records_t *records, const char *buffer, size_t length) {
+    records->buffer = buffer;
+    records->length = length;
+    records->offset = 0;
+    records->line   = 0;
+}
+
+
+/**
+ * @brief Prepare to iterate over the records of a NUL terminated, newline delimited, json buffer
+ *
+ * @param records the cursor to initialize
+ * @param buffer the records
+ */
+void json_inciter_records_init(json_inciter_records_t *records, const char *buffer) {
+    json_inciter_records_init_n(records, buffer, _JSON_INCITER_UNBOUNDED);
+}
+
+
+/**
+ * @brief Parse the root value of the next record. The cursor moves to the following line whatever the result, so a
+ * malformed record can be reported (`records->line`) and skipped.
+ *
+ * @param records the cursor
+ * @param element a pointer to the struct to be filled with the record (its flags select the parsing mode)
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_DONE after the last record, JSON_INCITER_INVALID for a malformed record
+ * (including anything but whitespace after the value) or JSON_INCITER_INCOMPLETE for a truncated one
+ */
+json_inciter_t json_inciter_records_next(json_inciter_records_t *records, json_inciter_element_t *element) {
+    const char *buffer = records->buffer;
+
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_RECORDS], 1);
+    for (;;) {
+        size_t start = records->offset;
+        size_t end   = 0;
+
+        if (_JSON_INCITER_AT_END(buffer, records->length, start)) {
+            return JSON_INCITER_DONE;
+        } else if (records->length == _JSON_INCITER_UNBOUNDED) {
+            end = start + strcspn(&buffer[start], "\n");
+        } else {
+            const char *newline = (const char *)memchr(&buffer[start], '\n', records->length - start);
+            end                 = newline != NULL ? (size_t)(newline - buffer) : records->length;
+        }
+        records->offset = end < records->length && buffer[end] == '\n' ? end + 1 : end;
+        records->line++;
+        _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_RECORDS], records->offset - start);
+
+        size_t line_length = end - start;
+        if (_json_inciter_skip_whitespace(&buffer[start], line_length) == line_length) {
+            continue;
+        }
+
+        // A record ends with its line
+        json_inciter_t result = json_inciter_parse_document_n(&buffer[start], line_length, element);
+        if (result == JSON_INCITER_OK && !(element->flags & _JSON_INCITER_FLAG_UNRESOLVED)) {
+            size_t value_end = (size_t)(element->start - &buffer[start]) + element->length;
+            if (_json_inciter_skip_whitespace(&buffer[start + value_end], line_length - value_end) !=
+                line_length - value_end) {
+                return JSON_INCITER_INVALID;
+            }
+        }
+        return result;
+    }
+}
+
+
+/**
+ * @brief Cut a newline delimited json buffer into byte ranges of about the same size, each starting at a record
+ * boundary. Range `i` spans from `bounds[i]` to `bounds[i + 1]`; a range is empty when a record is longer than the
+ * range size.
+ *
+ * @param buffer the records
+ * @param length the number of bytes in `buffer`
+ * @param n_ranges number of ranges, at least 1
+ * @param bounds array of `n_ranges + 1` offsets to be filled
+ */
+void json_inciter_records_partition_n(const char *buffer, size_t length, size_t n_ranges, size_t *bounds) {
+    bounds[0] = 0;
+    for (size_t i = 1; i < n_ranges; i++) {
+        size_t target = length / n_ranges * i;
+
+        // Search from the byte before the target so that a range already starting on a record is kept as is
+        target = target > bounds[i - 1] ? target - 1 : bounds[i - 1];
+
+        const char *newline = target < length ? (const char *)memchr(&buffer[target], '\n', length - target) : NULL;
+        bounds[i]           = newline != NULL ? (size_t)(newline - buffer) + 1 : length;
+    }
+    bounds[n_ranges] = length;
+}
+
+
+// Follow strings and nesting from `scan->offset` up to `end`, a whole aligned block at a time where possible (quote
+// parity gives the string mask, brackets outside of it the nesting). With `separator` set the scan stops on the
+// first comma outside of strings and nested containers instead.
+json_inciter_t _json_inciter_scan_nesting(const char *buffer, size_t end, uint8_t separator,
+                                          json_inciter_continuation_t *scan) {
+    size_t i = scan->offset;
+
+    while (i < end) {
+#ifdef _JSON_INCITER_SIMD
+        if (!separator && ((uintptr_t)&buffer[i] % 64) == 0 && end - i >= 64) {
+            _json_inciter_block_t masks        = {0, 0, 0, 0};
+            uint64_t              escape_carry = (scan->state & _JSON_INCITER_SCAN_ESCAPE) ? 1 : 0;
+
+            _json_inciter_classify_block(&buffer[i], &masks);
+            uint64_t escaped   = _json_inciter_escaped_mask(masks.backslash, &escape_carry);
+            uint64_t in_string = _json_inciter_prefix_xor(masks.quote & ~escaped);
+            if (scan->state & _JSON_INCITER_SCAN_STRING) {
+                in_string = ~in_string;
+            }
+
+            for (uint64_t structural = masks.bracket & ~in_string; structural != 0; structural &= structural - 1) {
+                switch (buffer[i + (size_t)__builtin_ctzll(structural)]) {
+                    case '[':
+                        scan->array_depth++;
+                        break;
+                    case '{':
+                        scan->object_depth++;
+                        break;
+                    case ']':
+                        if (scan->array_depth == 0) {
+                            return JSON_INCITER_INVALID;
+                        }
+                        scan->array_depth--;
+                        break;
+                    default:
+                        if (scan->object_depth == 0) {
+                            return JSON_INCITER_INVALID;
+                        }
+                        scan->object_depth--;
+                        break;
+                }
+            }
+
+            scan->state &= ~(_JSON_INCITER_SCAN_STRING | _JSON_INCITER_SCAN_ESCAPE);
+            scan->state |= (in_string >> 63) ? _JSON_INCITER_SCAN_STRING : 0;
+            scan->state |= escape_carry ? _JSON_INCITER_SCAN_ESCAPE : 0;
+            i += 64;
+            scan->offset = i;
+            continue;
+        }
+#endif
+
+        char current = buffer[i];
+        if (scan->state & _JSON_INCITER_SCAN_ESCAPE) {
+            scan->state &= ~_JSON_INCITER_SCAN_ESCAPE;
+        } else if (scan->state & _JSON_INCITER_SCAN_STRING) {
+            if (current == '\\') {
+                scan->state |= _JSON_INCITER_SCAN_ESCAPE;
+            } else if (current == '"') {
+                scan->state &= ~_JSON_INCITER_SCAN_STRING;
+            }
+        } else if (current == '"') {
+            scan->state |= _JSON_INCITER_SCAN_STRING;
+        } else if (current == '[') {
+            scan->array_depth++;
+        } else if (current == '{') {
+            scan->object_depth++;
+        } else if (current == ']' || current == '}') {
+            size_t *depth = current == ']' ? &scan->array_depth : &scan->object_depth;
+            if (*depth == 0) {
+                return JSON_INCITER_INVALID;
+            }
+            (*depth)--;
+        } else if (current == ',' && separator && scan->array_depth == 0 && scan->object_depth == 0) {
+            scan->offset = i;
+            return JSON_INCITER_OK;
+        }
+        i++;
+    }
+
+    scan->offset = end;
+    return JSON_INCITER_DONE;
+}
+
+
+/**
+ * @brief Cut an array into ranges of about the same size, each starting on an element, so that they can be iterated
+ * independently (e.g. by different threads) with `json_inciter_array_range_next`. Range `i` spans from offset
+ * `bounds[i]` to `bounds[i + 1]`, relative to `array.start`; a range is empty when an element is longer than the
+ * range size. Split points are found by following the string state (quote parity) and the nesting a block at a time,
+ * then moving to the next comma between elements.
+ *
+ * @param array the array, resolved if it is lazy
+ * @param n_ranges number of ranges, at least 1
+ * @param bounds array of `n_ranges + 1` offsets to be filled
+ *
+ * @return JSON_INCITER_OK, or the error found while resolving or splitting the array
+ */
+json_inciter_t json_inciter_array_partition(json_inciter_element_t array, size_t n_ranges, size_t *bounds) {
+    json_inciter_continuation_t scan = _JSON_INCITER_ZERO;
+    json_inciter_t              result;
+
+    if (array.tag != JSON_INCITER_ELEMENT_TAG_ARRAY) {
+        return JSON_INCITER_INVALID;
+    } else if ((result = json_inciter_element_resolve(&array)) != JSON_INCITER_OK) {
+        return result;
+    }
+
+    // Ranges end at the closing bracket
+    size_t end  = array.length - 1;
+    scan.offset = 1;
+    bounds[0]   = 1;
+    for (size_t i = 1; i < n_ranges; i++) {
+        size_t target = end / n_ranges * i;
+
+        if (target > scan.offset) {
+            result = _json_inciter_scan_nesting(array.start, target, 0, &scan);
+        }
+        if (result != JSON_INCITER_INVALID) {
+            result = _json_inciter_scan_nesting(array.start, end, 1, &scan);
+        }
+        if (result == JSON_INCITER_INVALID) {
+            return result;
+        } else if (result == JSON_INCITER_OK) {
+            // Past the comma, out of any string
+            scan.offset++;
+        }
+        bounds[i] = scan.offset;
+    }
+    bounds[n_ranges] = end;
+
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Parse the next element of a range of an array (see `json_inciter_array_partition`) and move past it
+ *
+ * @param buffer the start of the array
+ * @param end offset of the end of the range
+ * @param offset offset of the element to parse, moved to the next one
+ * @param element a pointer to the struct to be filled with the element (its flags select the parsing mode)
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_DONE at the end of the range, or the error found
+ */
+json_inciter_t json_inciter_array_range_next(const char *buffer, size_t end, size_t *offset,
+                                             json_inciter_element_t *element) {
+    size_t         index = *offset + _json_inciter_skip_whitespace(&buffer[*offset], end - *offset);
+    json_inciter_t result;
+
+    if (index >= end) {
+        return JSON_INCITER_DONE;
+    }
+    // Ranges end on the closing bracket or past a comma, so nothing can follow a number cut by them
+    else if ((result = _json_inciter_parse_bounded(&buffer[index], end - index, _JSON_INCITER_SCAN_FINAL, element)) !=
+             JSON_INCITER_OK) {
+        return result;
+    }
+
+    const char *next = json_inciter_element_next_start(element);
+    if (next == NULL) {
+        return JSON_INCITER_INVALID;
+    }
+    index = (size_t)(next - buffer);
+    index += _json_inciter_skip_whitespace(&buffer[index], end - index);
+    if (index < end) {
+        if (buffer[index] != ',') {
+            return JSON_INCITER_INVALID;
+        }
+        index++;
+    }
+    *offset = index;
+    return JSON_INCITER_OK;
+}
+
+
+#ifdef JSON_INCITER_THREADS
+
+// Ranges below each worker, so that a worker done early can take over the remaining ones
+#define _JSON_INCITER_RANGES_PER_THREAD 8
+
+// State shared by the workers of `json_inciter_records_parallel_n` and `json_inciter_array_parallel`
+typedef struct {
+    const char                    *buffer;     // Records, or the array whose elements are split
+    size_t                         bounds[JSON_INCITER_MAX_THREADS * _JSON_INCITER_RANGES_PER_THREAD + 1];
+    json_inciter_t                 results[JSON_INCITER_MAX_THREADS * _JSON_INCITER_RANGES_PER_THREAD];
+    size_t                         n_ranges;
+    size_t                         next_range;     // Next range to be handed out, guarded by `lock`
+    uint8_t                        stopped;        // A callback failed, guarded by `lock`
+    uint8_t                        ordered;
+    uint8_t                        elements;     // Ranges hold array elements rather than lines
+    uint8_t                        flags;
+    json_inciter_record_callback_t callback;
+    void *const                   *contexts;
+    pthread_mutex_t                lock;
+} _json_inciter_pool_t;
+
+typedef struct {
+    _json_inciter_pool_t *pool;
+    size_t                worker;
+    pthread_t             thread;
+#ifdef JSON_INCITER_STATS
+    json_inciter_stats_t stats;     // Counters of the thread, added to the calling thread's once it is joined
+#endif
+} _json_inciter_worker_t;
+
+
+// Parse ranges of records or elements, as handed out by the pool, until none is left
+void *_json_inciter_pool_worker(void *argument) {
+    _json_inciter_worker_t *worker = (_json_inciter_worker_t *)argument;
+    _json_inciter_pool_t   *pool   = worker->pool;
+
+    for (;;) {
+        size_t range = pool->n_ranges;
+
+        pthread_mutex_lock(&pool->lock);
+        if (!pool->stopped && pool->next_range < pool->n_ranges) {
+            range = pool->next_range++;
+        }
+        pthread_mutex_unlock(&pool->lock);
+        if (range == pool->n_ranges) {
+#ifdef JSON_INCITER_STATS
+            if (worker->worker > 0) {
+                worker->stats = *_JSON_INCITER_STATS;
+            }
+#endif
+            return NULL;
+        }
+
+        json_inciter_records_t records = _JSON_INCITER_ZERO;
+        json_inciter_element_t element = _JSON_INCITER_ZERO;
+        json_inciter_t         result;
+        size_t                 offset  = pool->bounds[range];
+        void                  *context = pool->contexts[pool->ordered ? range : worker->worker];
+
+        json_inciter_records_init_n(&records, &pool->buffer[offset], pool->bounds[range + 1] - offset);
+        element.flags = pool->flags;
+        for (;;) {
+            result = pool->elements
+                         ? json_inciter_array_range_next(pool->buffer, pool->bounds[range + 1], &offset, &element)
+                         : json_inciter_records_next(&records, &element);
+            if (result == JSON_INCITER_DONE) {
+                break;
+            }
+
+            json_inciter_t callback_result = pool->callback(context, result, &element);
+            if (callback_result != JSON_INCITER_OK) {
+                pool->results[range] = callback_result;
+                pthread_mutex_lock(&pool->lock);
+                pool->stopped = 1;
+                pthread_mutex_unlock(&pool->lock);
+                break;
+            }
+        }
+    }
+}
+
+
+// Run the pool with `n_threads` workers, the calling thread included, and gather the first failure in buffer order
+json_inciter_t _json_inciter_pool_run(_json_inciter_pool_t *pool, size_t n_threads) {
+    _json_inciter_worker_t workers[JSON_INCITER_MAX_THREADS];
+
+    pthread_mutex_init(&pool->lock, NULL);
+
+    // A thread that cannot be created leaves its share to the others
+    for (size_t i = 0; i < n_threads; i++) {
+        workers[i].pool   = pool;
+        workers[i].worker = i;
+        if (i > 0 && pthread_create(&workers[i].thread, NULL, _json_inciter_pool_worker, &workers[i]) != 0) {
+            workers[i].pool = NULL;
+        }
+    }
+    _json_inciter_pool_worker(&workers[0]);
+    for (size_t i = 1; i < n_threads; i++) {
+        if (workers[i].pool != NULL) {
+            pthread_join(workers[i].thread, NULL);
+#ifdef JSON_INCITER_STATS
+            _json_inciter_stats_add(_JSON_INCITER_STATS, &workers[i].stats);
+#endif
+        }
+    }
+    pthread_mutex_destroy(&pool->lock);
+
+    for (size_t i = 0; i < pool->n_ranges; i++) {
+        if (pool->results[i] != JSON_INCITER_OK) {
+            return pool->results[i];
+        }
+    }
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Parse the records of a newline delimited json buffer with a pool of threads, the calling one included. The
+ * buffer is cut at record boundaries (see `json_inciter_records_partition_n`) and every record is passed to
+ * `callback`, from the thread that parsed it.
+ * When `ordered` is set there is one range, and one context, per thread: range `i` is parsed, in order, with
+ * `contexts[i]`, so results gathered per context can be joined back in record order. Otherwise the buffer is cut
+ * into smaller ranges handed out as workers become idle, which balances uneven records better, and `contexts[i]` is
+ * used by worker `i` for all the ranges it takes.
+ * Once a callback fails no further range is started.
+ *
+ * @param buffer the records
+ * @param length the number of bytes in `buffer`
+ * @param flags parsing mode of the records (json_inciter_flag_t)
+ * @param n_threads number of threads, up to JSON_INCITER_MAX_THREADS
+ * @param ordered whether record order is preserved across contexts
+ * @param callback called for every record
+ * @param contexts array of `n_threads` contexts passed to `callback`
+ *
+ * @return JSON_INCITER_OK once every record has been passed to `callback`, JSON_INCITER_OVERFLOW for too many threads,
+ * or the first failure returned by `callback`, in buffer order
+ */
+json_inciter_t json_inciter_records_parallel_n(const char *buffer, size_t length, uint8_t flags, size_t n_threads,
+                                               uint8_t ordered, json_inciter_record_callback_t callback,
+                                               void *const *contexts) {
+    _json_inciter_pool_t pool;
+
+    if (n_threads == 0 || n_threads > JSON_INCITER_MAX_THREADS) {
+        return JSON_INCITER_OVERFLOW;
+    }
+
+    memset(&pool, 0, sizeof(pool));
+    pool.buffer   = buffer;
+    pool.n_ranges = ordered ? n_threads : n_threads * _JSON_INCITER_RANGES_PER_THREAD;
+    pool.ordered  = ordered;
+    pool.flags    = flags;
+    pool.callback = callback;
+    pool.contexts = contexts;
+    json_inciter_records_partition_n(buffer, length, pool.n_ranges, pool.bounds);
+
+    return _json_inciter_pool_run(&pool, n_threads);
+}
+
+
+/**
+ * @brief Parse the elements of an array with a pool of threads, the calling one included. The array is cut between
+ * elements (see `json_inciter_array_partition`) and every element is passed to `callback`, with the same contexts and
+ * ordering as `json_inciter_records_parallel_n`.
+ *
+ * @param array the array
+ * @param flags parsing mode of the elements (json_inciter_flag_t)
+ * @param n_threads number of threads, up to JSON_INCITER_MAX_THREADS
+ * @param ordered whether element order is preserved across contexts
+ * @param callback called for every element
+ * @param contexts array of `n_threads` contexts passed to `callback`
+ *
+ * @return JSON_INCITER_OK once every element has been passed to `callback`, JSON_INCITER_OVERFLOW for too many
+ * threads, the error found while splitting the array, or the first failure returned by `callback`, in array order
+ */
+json_inciter_t json_inciter_array_parallel(json_inciter_element_t array, uint8_t flags, size_t n_threads,
+                                           uint8_t ordered, json_inciter_record_callback_t callback,
+                                           void *const *contexts) {
+    _json_inciter_pool_t pool;
+    json_inciter_t       result;
+
+    if (n_threads == 0 || n_threads > JSON_INCITER_MAX_THREADS) {
+        return JSON_INCITER_OVERFLOW;
+    }
+
+    memset(&pool, 0, sizeof(pool));
+    pool.buffer   = array.start;
+    pool.n_ranges = ordered ? n_threads : n_threads * _JSON_INCITER_RANGES_PER_THREAD;
+    pool.ordered  = ordered;
+    pool.elements = 1;
+    pool.flags    = flags;
+    pool.callback = callback;
+    pool.contexts = contexts;
+    if ((result = json_inciter_array_partition(array, pool.n_ranges, pool.bounds)) != JSON_INCITER_OK) {
+        return result;
+    }
+
+    return _json_inciter_pool_run(&pool, n_threads);
+}
+
+#endif
+
+
+// Move a position in a segmented stream to the next byte that is not whitespace
+json_inciter_t _json_inciter_segments_skip_whitespace(const json_inciter_segments_t *segments, size_t *segment,
+                                                      size_t *offset) {
+    for (; *segment < segments->n_segments; (*segment)++, *offset = 0) {
+        const json_inciter_segment_t *current = &segments->segments[*segment];
+
+        *offset += _json_inciter_skip_whitespace(&current->buffer[*offset], current->length - *offset);
+        if (*offset < current->length) {
+            return current->buffer[*offset] == '\0' ? JSON_INCITER_INCOMPLETE : JSON_INCITER_OK;
+        }
+    }
+    return JSON_INCITER_INCOMPLETE;
+}
+
+
+// Move a position in a segmented stream forward by `length` bytes
+void _json_inciter_segments_advance(const json_inciter_segments_t *segments, size_t *segment, size_t *offset,
+                                    size_t length) {
+    while (*segment < segments->n_segments && length >= segments->segments[*segment].length - *offset) {
+        length -= segments->segments[*segment].length - *offset;
+        (*segment)++;
+        *offset = 0;
+    }
+    *offset += length;
+}
+
+
+// Length of the value starting at a position of a segmented stream, following strings and containers across
+// segments with the resumable scanners
+json_inciter_t _json_inciter_segments_span(const json_inciter_segments_t *segments, size_t segment, size_t offset,
+                                           size_t *length) {
+    const char                 *buffer     = segments->segments[segment].buffer;
+    _json_inciter_token_t       token      = _json_inciter_get_next_token_type(buffer[offset]);
+    char                        terminator = token == _JSON_INCITER_TOKEN_ARRAY ? ']' : '}';
+    json_inciter_continuation_t scan       = _JSON_INCITER_ZERO;
+
+    // Bytes that cannot start a value fall in the keyword class; the rest of a keyword is left to the parse
+    if (token == _JSON_INCITER_TOKEN_KEYWORD && buffer[offset] != 't' && buffer[offset] != 'f' &&
+        buffer[offset] != 'n') {
+        return JSON_INCITER_INVALID;
+    }
+
+    // Past the opening quote or bracket
+    *length = token == _JSON_INCITER_TOKEN_NUMBER || token == _JSON_INCITER_TOKEN_KEYWORD ? 0 : 1;
+    offset += *length;
+
+    for (; segment < segments->n_segments; segment++, offset = 0) {
+        size_t         segment_length = segments->segments[segment].length;
+        size_t         index          = offset;
+        json_inciter_t result         = JSON_INCITER_INCOMPLETE;
+
+        buffer = segments->segments[segment].buffer;
+        switch (token) {
+            case _JSON_INCITER_TOKEN_STRING:
+                index += _json_inciter_skip_string(&buffer[offset], segment_length - offset, &scan.state);
+                result = index < segment_length && buffer[index] == '"' ? JSON_INCITER_OK : result;
+                break;
+
+            case _JSON_INCITER_TOKEN_ARRAY:
+            case _JSON_INCITER_TOKEN_OBJECT:
+                scan.offset = offset;
+                result      = _json_inciter_skip_to_terminator(buffer, segment_length, terminator, &scan);
+                index       = scan.offset;
+                break;
+
+            default:
+                while (index < segment_length && !IS_TERMINATOR(buffer[index]) && buffer[index] != '\0') {
+                    index++;
+                }
+                // Numbers and keywords end on the first terminator; at the end of the stream, only a keyword is known
+                // to be whole, a number may go on in a segment yet to come
+                if (index < segment_length ||
+                    (segment + 1 == segments->n_segments && token == _JSON_INCITER_TOKEN_KEYWORD)) {
+                    *length += index - offset;
+                    return JSON_INCITER_OK;
+                }
+                break;
+        }
+
+        if (result == JSON_INCITER_OK) {
+            *length += index - offset + 1;
+            return result;
+        } else if (result != JSON_INCITER_INCOMPLETE || index < segment_length) {
+            // Invalid, or stopped by a NUL character
+            return result;
+        }
+        *length += segment_length - offset;
+    }
+
+    return JSON_INCITER_INCOMPLETE;
+}
+
+
+// Copy `length` bytes of a segmented stream, from a position, into `destination`
+void _json_inciter_segments_gather(const json_inciter_segments_t *segments, size_t segment, size_t offset,
+                                   size_t length, char *destination) {
+    while (length > 0) {
+        size_t available = segments->segments[segment].length - offset;
+        size_t chunk     = length < available ? length : available;
+
+        memcpy(destination, &segments->segments[segment].buffer[offset], chunk);
+        destination += chunk;
+        length -= chunk;
+        segment++;
+        offset = 0;
+    }
+}
+
+
+// Parse the value at a position of a segmented stream and move the cursor past it: in place when it lies in a single
+// segment, otherwise from its copy in the scratch buffer, after a key that is still in use
+json_inciter_t _json_inciter_segments_take(json_inciter_segments_t *segments, size_t segment, size_t offset,
+                                           json_inciter_element_t *element) {
+    const json_inciter_segment_t *current = &segments->segments[segment];
+    size_t                        length  = 0;
+    json_inciter_t result = json_inciter_parse_value_n(&current->buffer[offset], current->length - offset, element);
+
+    segments->copied = 0;
+    if (result == JSON_INCITER_OK && (element->flags & _JSON_INCITER_FLAG_UNRESOLVED)) {
+        result = json_inciter_element_resolve(element);
+    }
+
+    // A value reaching the end of the segment, numbers included, may go on in the next one; once its span is known,
+    // nothing follows it
+    if (result == JSON_INCITER_OK) {
+        length = element->length;
+    } else if (result != JSON_INCITER_INCOMPLETE) {
+        return result;
+    } else if ((result = _json_inciter_segments_span(segments, segment, offset, &length)) != JSON_INCITER_OK) {
+        return result;
+    } else if (length <= current->length - offset) {
+        result = _json_inciter_parse_bounded(&current->buffer[offset], length, _JSON_INCITER_SCAN_FINAL, element);
+    } else if (segments->scratch_used + length > segments->scratch_size) {
+        segments->required = segments->scratch_used + length;
+        return JSON_INCITER_OVERFLOW;
+    } else {
+        char *copy = &segments->scratch[segments->scratch_used];
+        _json_inciter_segments_gather(segments, segment, offset, length, copy);
+        segments->copied = 1;
+        result           = _json_inciter_parse_bounded(copy, length, _JSON_INCITER_SCAN_FINAL, element);
+    }
+
+    if (result == JSON_INCITER_OK) {
+        _json_inciter_segments_advance(segments, &segment, &offset, length);
+        segments->segment = segment;
+        segments->offset  = offset;
+    }
+    return result;
+}
+
+
+/**
+ * @brief Prepare to parse a json stream spread across segments
+ *
+ * @param segments the cursor to initialize
+ * @param list the segments, in stream order; the list can grow (and `segments->n_segments` be updated) after a call
+ * returns JSON_INCITER_INCOMPLETE, which leaves the cursor unchanged
+ * @param n_segments number of segments
+ * @param scratch buffer the elements straddling segments are copied into, may be NULL
+ * @param scratch_size size of `scratch`
+ */
+void json_inciter_segments_init(json_inciter_segments_t *segments, const json_inciter_segment_t *list,
+                                size_t n_segments, char *scratch, size_t scratch_size) {
+    segments->segments     = list;
+    segments->n_segments   = n_segments;
+    segments->segment      = 0;
+    segments->offset       = 0;
+    segments->scratch      = scratch;
+    segments->scratch_size = scratch_size;
+    segments->scratch_used = 0;
+    segments->required     = 0;
+    segments->copied       = 0;
+}
+
+
+/**
+ * @brief Parse the value at the cursor and move past it. A value lying in a single segment is parsed in place; one
+ * that straddles a boundary is first copied into the scratch buffer (`segments->copied` tells), where it stays valid
+ * until the next call. Inside a container, its closing bracket ends the iteration.
+ *
+ * @param segments the cursor
+ * @param element a pointer to the struct to be filled with the element (its flags select the parsing mode)
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_DONE if a closing bracket was found (and skipped), JSON_INCITER_OVERFLOW if the
+ * value straddles segments and `segments->required` bytes of scratch are needed, JSON_INCITER_INVALID or
+ * JSON_INCITER_INCOMPLETE; the cursor only moves when the result is JSON_INCITER_OK or JSON_INCITER_DONE
+ */
+json_inciter_t json_inciter_segments_parse_value(json_inciter_segments_t *segments, json_inciter_element_t *element) {
+    size_t         segment = segments->segment;
+    size_t         offset  = segments->offset;
+    json_inciter_t result;
+
+    if ((result = _json_inciter_segments_skip_whitespace(segments, &segment, &offset)) != JSON_INCITER_OK) {
+        return result;
+    }
+
+    char current = segments->segments[segment].buffer[offset];
+    if (current == ']' || current == '}') {
+        segments->segment = segment;
+        segments->offset  = offset + 1;
+        result            = JSON_INCITER_DONE;
+    } else if ((result = _json_inciter_segments_take(segments, segment, offset, element)) != JSON_INCITER_OK) {
+        return result;
+    }
+
+    segments->scratch_used = 0;
+    return result;
+}
+
+
+/**
+ * @brief Parse the key at the cursor, inside an object, and move to its value, to be parsed with
+ * `json_inciter_segments_parse_value` or entered with `json_inciter_segments_enter`. A key straddling segments is
+ * copied at the start of the scratch buffer, where it stays valid while its value is parsed.
+ *
+ * @param segments the cursor
+ * @param key a pointer to the struct to be filled with the key, a string element
+ *
+ * @return as `json_inciter_segments_parse_value`
+ */
+json_inciter_t json_inciter_segments_parse_key(json_inciter_segments_t *segments, json_inciter_element_t *key) {
+    size_t         segment = segments->segment;
+    size_t         offset  = segments->offset;
+    json_inciter_t result;
+
+    segments->scratch_used = 0;
+    if ((result = _json_inciter_segments_skip_whitespace(segments, &segment, &offset)) != JSON_INCITER_OK) {
+        return result;
+    }
+
+    char current = segments->segments[segment].buffer[offset];
+    if (current == '}') {
+        segments->segment = segment;
+        segments->offset  = offset + 1;
+        return JSON_INCITER_DONE;
+    } else if (current != '"') {
+        return JSON_INCITER_INVALID;
+    }
+
+    // The cursor is put back unless the separator follows the key
+    size_t start_segment = segments->segment;
+    size_t start_offset  = segments->offset;
+    if ((result = _json_inciter_segments_take(segments, segment, offset, key)) != JSON_INCITER_OK) {
+        return result;
+    }
+    segment = segments->segment;
+    offset  = segments->offset;
+    if ((result = _json_inciter_segments_skip_whitespace(segments, &segment, &offset)) == JSON_INCITER_OK &&
+        segments->segments[segment].buffer[offset] != ':') {
+        result = JSON_INCITER_INVALID;
+    }
+    if (result != JSON_INCITER_OK) {
+        segments->segment = start_segment;
+        segments->offset  = start_offset;
+        return result;
+    }
+
+    segments->scratch_used = segments->copied ? key->length : 0;
+    segments->segment      = segment;
+    segments->offset       = offset + 1;
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Move the cursor inside the array or object it is on, so that its elements can be parsed one at a time
+ * instead of as a whole
+ *
+ * @param segments the cursor
+ * @param tag pointer to be filled with JSON_INCITER_ELEMENT_TAG_ARRAY or JSON_INCITER_ELEMENT_TAG_OBJECT
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID if the cursor is not on a container, or JSON_INCITER_INCOMPLETE
+ */
+json_inciter_t json_inciter_segments_enter(json_inciter_segments_t *segments, json_inciter_element_tag_t *tag) {
+    size_t         segment = segments->segment;
+    size_t         offset  = segments->offset;
+    json_inciter_t result  = _json_inciter_segments_skip_whitespace(segments, &segment, &offset);
+
+    if (result != JSON_INCITER_OK) {
+        return result;
+    }
+
+    switch (segments->segments[segment].buffer[offset]) {
+        case '[':
+            *tag = JSON_INCITER_ELEMENT_TAG_ARRAY;
+            break;
+        case '{':
+            *tag = JSON_INCITER_ELEMENT_TAG_OBJECT;
+            break;
+        default:
+            return JSON_INCITER_INVALID;
+    }
+    segments->segment      = segment;
+    segments->offset       = offset + 1;
+    segments->scratch_used = 0;
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Move the cursor past the comma that separates two elements of a container, or past the end of the container
+ * (see `json_inciter_next_element_start`)
+ *
+ * @param segments the cursor
+ * @param tag JSON_INCITER_ELEMENT_TAG_OBJECT or JSON_INCITER_ELEMENT_TAG_ARRAY
+ *
+ * @return JSON_INCITER_OK before another element, JSON_INCITER_DONE past the end of the container,
+ * JSON_INCITER_INVALID or JSON_INCITER_INCOMPLETE
+ */
+json_inciter_t json_inciter_segments_next_element_start(json_inciter_segments_t   *segments,
+                                                        json_inciter_element_tag_t tag) {
+    size_t         segment = segments->segment;
+    size_t         offset  = segments->offset;
+    json_inciter_t result  = _json_inciter_segments_skip_whitespace(segments, &segment, &offset);
+
+    if (result != JSON_INCITER_OK) {
+        return result;
+    }
+
+    char current = segments->segments[segment].buffer[offset];
+    if (current == ',') {
+        result = JSON_INCITER_OK;
+    } else if (current == (tag == JSON_INCITER_ELEMENT_TAG_OBJECT ? '}' : ']')) {
+        result = JSON_INCITER_DONE;
+    } else {
+        return JSON_INCITER_INVALID;
+    }
+    segments->segment = segment;
+    segments->offset  = offset + 1;
+    return result;
+}
+
+
+// Report a bracket to a walk callback
+json_inciter_action_t _json_inciter_walk_bracket(const char *bracket, json_inciter_event_t event,
+                                                 json_inciter_event_callback_t callback, void *context) {
+    json_inciter_element_t element = _JSON_INCITER_ZERO;
+
+    element.tag = event == JSON_INCITER_EVENT_BEGIN_ARRAY || event == JSON_INCITER_EVENT_END_ARRAY
+                      ? JSON_INCITER_ELEMENT_TAG_ARRAY
+                      : JSON_INCITER_ELEMENT_TAG_OBJECT;
+    element.start  = bracket;
+    element.length = 1;
+    return callback(context, event, &element);
+}
+
+
+/**
+ * @brief Walk a whole json value of known length in a single pass, reporting every container bracket, key and scalar
+ * to `callback` in document order. Nesting is tracked with a bounded stack instead of recursion, so each byte is read
+ * once whatever the depth, and subtrees skipped by the callback are only scanned for their end.
+ * Events are reported as the value is read: an invalid or incomplete value can be reported in part before the error.
+ * The value ends with the buffer, so a top level number may run up to `length`.
+ *
+ * @param buffer the json string
+ * @param length the number of bytes available in `buffer`
+ * @param flags parsing mode of the scalars (json_inciter_flag_t)
+ * @param callback called for every event, returns the action to take
+ * @param context passed to `callback`
+ *
+ * @return JSON_INCITER_OK once the value has been walked, JSON_INCITER_DONE if `callback` stopped the walk,
+ * JSON_INCITER_OVERFLOW if the value is nested deeper than JSON_INCITER_MAX_DEPTH, JSON_INCITER_INVALID or
+ * JSON_INCITER_INCOMPLETE
+ */
+json_inciter_t json_inciter_walk_n(const char *buffer, size_t length, uint8_t flags,
+                                   json_inciter_event_callback_t callback, void *context) {
+    uint8_t               objects[(JSON_INCITER_MAX_DEPTH + 7) / 8];     // One bit per open container, set for objects
+    size_t                depth         = 0;
+    size_t                parsing_index = 0;
+    uint8_t               expect_key    = 0;
+    json_inciter_action_t action        = JSON_INCITER_ACTION_CONTINUE;
+    json_inciter_t        result;
+
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_WALK], 1);
+    for (;;) {
+        json_inciter_element_t element = _JSON_INCITER_ZERO;
+
+        parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+        if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+            return JSON_INCITER_INCOMPLETE;
+        }
+
+        // Object keys, followed by a colon
+        if (expect_key) {
+            json_inciter_continuation_t continuation = _JSON_INCITER_ZERO;
+
+            result = _json_inciter_parse_value_of_type(&buffer[parsing_index], length - parsing_index,
+                                                       _JSON_INCITER_TOKEN_STRING, &continuation, &element);
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+            action = callback(context, JSON_INCITER_EVENT_KEY, &element);
+            if (action == JSON_INCITER_ACTION_STOP) {
+                return JSON_INCITER_DONE;
+            }
+
+            parsing_index += element.length;
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+            if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[parsing_index] != ':') {
+                return JSON_INCITER_INVALID;
+            }
+            parsing_index++;
+            expect_key = 0;
+
+            if (action != JSON_INCITER_ACTION_SKIP) {
+                continue;
+            }
+
+            // The value of a skipped key is parsed without events
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+            element.flags = JSON_INCITER_FLAG_LAZY_NUMBERS;
+            result = json_inciter_parse_value_n(&buffer[parsing_index], _JSON_INCITER_REMAINING(length, parsing_index),
+                                                &element);
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+            parsing_index += element.length;
+        }
+        // Containers are pushed on the stack, unless the callback skips them
+        else if (buffer[parsing_index] == '[' || buffer[parsing_index] == '{') {
+            uint8_t is_object = buffer[parsing_index] == '{';
+
+            action = _json_inciter_walk_bracket(&buffer[parsing_index],
+                                                is_object ? JSON_INCITER_EVENT_BEGIN_OBJECT
+                                                          : JSON_INCITER_EVENT_BEGIN_ARRAY,
+                                                callback, context);
+            if (action == JSON_INCITER_ACTION_STOP) {
+                return JSON_INCITER_DONE;
+            } else if (action == JSON_INCITER_ACTION_SKIP) {
+                json_inciter_continuation_t continuation = _JSON_INCITER_ZERO;
+
+                continuation.value_offset = parsing_index;
+                continuation.offset       = parsing_index + 1;
+                continuation.state        = _JSON_INCITER_SCAN_VALUE;
+                result = _json_inciter_skip_to_terminator(buffer, length, is_object ? '}' : ']', &continuation);
+                if (result != JSON_INCITER_OK) {
+                    return result;
+                }
+                parsing_index = continuation.offset + 1;
+            } else if (depth == JSON_INCITER_MAX_DEPTH) {
+                return JSON_INCITER_OVERFLOW;
+            } else {
+                objects[depth / 8] &= (uint8_t)~(1u << (depth % 8));
+                objects[depth / 8] |= (uint8_t)(is_object << (depth % 8));
+                depth++;
+                parsing_index++;
+
+                parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+                if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                    return JSON_INCITER_INCOMPLETE;
+                } else if (buffer[parsing_index] != (is_object ? '}' : ']')) {
+                    expect_key = is_object;
+                    continue;
+                }
+            }
+        }
+        // Scalars, the top level one ending with the buffer
+        else {
+            element.flags = flags;
+            result        = _json_inciter_parse_bounded(&buffer[parsing_index],
+                                                        _JSON_INCITER_REMAINING(length, parsing_index),
+                                                        depth == 0 ? _JSON_INCITER_SCAN_FINAL : 0, &element);
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+            if (callback(context, JSON_INCITER_EVENT_SCALAR, &element) == JSON_INCITER_ACTION_STOP) {
+                return JSON_INCITER_DONE;
+            }
+            parsing_index += element.length;
+        }
+
+        // After a value: close containers until a comma, or the end of the top level value, is found
+        for (;;) {
+            if (depth == 0) {
+                _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_WALK], parsing_index);
+                return JSON_INCITER_OK;
+            }
+
+            uint8_t is_object = (objects[(depth - 1) / 8] >> ((depth - 1) % 8)) & 1;
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+            if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[parsing_index] == ',') {
+                parsing_index++;
+                expect_key = is_object;
+                break;
+            } else if (buffer[parsing_index] != (is_object ? '}' : ']')) {
+                return JSON_INCITER_INVALID;
+            }
+
+            action = _json_inciter_walk_bracket(&buffer[parsing_index],
+                                                is_object ? JSON_INCITER_EVENT_END_OBJECT
+                                                          : JSON_INCITER_EVENT_END_ARRAY,
+                                                callback, context);
+            if (action == JSON_INCITER_ACTION_STOP) {
+                return JSON_INCITER_DONE;
+            }
+            parsing_index++;
+            depth--;
+        }
+    }
+}
+
+
+/**
+ * @brief Walk a whole NUL terminated json value (see `json_inciter_walk_n`)
+ *
+ * @param buffer the json string
+ * @param flags parsing mode of the scalars (json_inciter_flag_t)
+ * @param callback called for every event, returns the action to take
+ * @param context passed to `callback`
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_walk(const char *buffer, uint8_t flags, json_inciter_event_callback_t callback,
+                                 void *context) {
+    return json_inciter_walk_n(buffer, _JSON_INCITER_UNBOUNDED, flags, callback, context);
+}
+
+
+// Append an entry to a tape being built
+json_inciter_t _json_inciter_tape_push(uint32_t *tape, size_t capacity, size_t *entries,
+                                       json_inciter_element_tag_t tag, size_t offset, size_t end, size_t next) {
+    if ((*entries + 1) * JSON_INCITER_TAPE_ENTRY_WORDS > capacity || *entries >= _JSON_INCITER_TAPE_NEXT_MASK ||
+        end > UINT32_MAX) {
+        return JSON_INCITER_OVERFLOW;
+    }
+
+    uint32_t *entry = &tape[*entries * JSON_INCITER_TAPE_ENTRY_WORDS];
+
+    entry[_JSON_INCITER_TAPE_OFFSET] = (uint32_t)offset;
+    entry[_JSON_INCITER_TAPE_END]    = (uint32_t)end;
+    entry[_JSON_INCITER_TAPE_LINK]   = ((uint32_t)tag << _JSON_INCITER_TAPE_TAG_SHIFT) | (uint32_t)next;
+    (*entries)++;
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Index a json value, of known length, into a caller provided tape so that it can be queried many times
+ * without being scanned again. Every value, and every object key, gets an entry in document order, holding its tag,
+ * its span and the index of the entry following its subtree, so that siblings are reached in constant time. The
+ * containers are laid out as their children (alternating keys and values for objects) right after their own entry.
+ *
+ * @param buffer the json string
+ * @param length the number of bytes available in `buffer`
+ * @param tape caller provided array of `capacity` words, see `JSON_INCITER_TAPE_WORDS`
+ * @param capacity number of words in `tape`
+ * @param entries pointer to be filled with the number of entries written
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_OVERFLOW if the tape is too small (or the value spans more than 4 GiB),
+ * JSON_INCITER_INVALID or JSON_INCITER_INCOMPLETE as `json_inciter_parse_document_n`, the value ending with the buffer
+ */
+json_inciter_t json_inciter_tape_build_n(const char *buffer, size_t length, uint32_t *tape, size_t capacity,
+                                         size_t *entries) {
+    size_t         parsing_index = 0;
+    size_t         open          = _JSON_INCITER_TAPE_NEXT_MASK;     // Innermost open container
+    uint8_t        expect_key    = 0;
+    json_inciter_t result;
+
+    *entries = 0;
+    _JSON_INCITER_STATS_ADD(calls[JSON_INCITER_STATS_TAPE], 1);
+
+    for (;;) {
+        json_inciter_element_t element = _JSON_INCITER_ZERO;
+
+        parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+        if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+            return JSON_INCITER_INCOMPLETE;
+        }
+
+        // Object keys, followed by a colon
+        if (expect_key) {
+            json_inciter_continuation_t continuation = _JSON_INCITER_ZERO;
+
+            result = _json_inciter_parse_value_of_type(&buffer[parsing_index], length - parsing_index,
+                                                       _JSON_INCITER_TOKEN_STRING, &continuation, &element);
+            if (result == JSON_INCITER_OK) {
+                result = _json_inciter_tape_push(tape, capacity, entries, JSON_INCITER_ELEMENT_TAG_STRING,
+                                                 parsing_index, parsing_index + element.length, *entries + 1);
+            }
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+
+            parsing_index += element.length;
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+            if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[parsing_index] != ':') {
+                return JSON_INCITER_INVALID;
+            }
+            parsing_index++;
+            expect_key = 0;
+            continue;
+        }
+
+        // Containers are linked to their parent until they are closed
+        if (buffer[parsing_index] == '[' || buffer[parsing_index] == '{') {
+            json_inciter_element_tag_t tag =
+                buffer[parsing_index] == '[' ? JSON_INCITER_ELEMENT_TAG_ARRAY : JSON_INCITER_ELEMENT_TAG_OBJECT;
+
+            result = _json_inciter_tape_push(tape, capacity, entries, tag, parsing_index, parsing_index, open);
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+            open = *entries - 1;
+            parsing_index++;
+
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+            if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[parsing_index] != (tag == JSON_INCITER_ELEMENT_TAG_ARRAY ? ']' : '}')) {
+                expect_key = tag == JSON_INCITER_ELEMENT_TAG_OBJECT;
+                continue;
+            }
+        }
+        // Scalars, the top level one ending with the buffer
+        else {
+            element.flags = JSON_INCITER_FLAG_LAZY_NUMBERS;
+            result        = _json_inciter_parse_bounded(
+                &buffer[parsing_index], _JSON_INCITER_REMAINING(length, parsing_index),
+                open == _JSON_INCITER_TAPE_NEXT_MASK ? _JSON_INCITER_SCAN_FINAL : 0, &element);
+            if (result == JSON_INCITER_OK) {
+                result = _json_inciter_tape_push(tape, capacity, entries, element.tag, parsing_index,
+                                                 parsing_index + element.length, *entries + 1);
+            }
+            if (result != JSON_INCITER_OK) {
+                return result;
+            }
+            parsing_index += element.length;
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+        }
+
+        // After a value: close containers until a comma, or the end of the top level value, is found
+        for (;;) {
+            if (open == _JSON_INCITER_TAPE_NEXT_MASK) {
+                _JSON_INCITER_STATS_ADD(bytes[JSON_INCITER_STATS_TAPE], parsing_index);
+                return JSON_INCITER_OK;
+            }
+
+            uint32_t                  *container = &tape[open * JSON_INCITER_TAPE_ENTRY_WORDS];
+            json_inciter_element_tag_t tag =
+                (json_inciter_element_tag_t)(container[_JSON_INCITER_TAPE_LINK] >> _JSON_INCITER_TAPE_TAG_SHIFT);
+
+            if (_JSON_INCITER_AT_END(buffer, length, parsing_index)) {
+                return JSON_INCITER_INCOMPLETE;
+            } else if (buffer[parsing_index] == ',') {
+                parsing_index++;
+                expect_key = tag == JSON_INCITER_ELEMENT_TAG_OBJECT;
+                break;
+            } else if (buffer[parsing_index] != (tag == JSON_INCITER_ELEMENT_TAG_ARRAY ? ']' : '}')) {
+                return JSON_INCITER_INVALID;
+            }
+
+            parsing_index++;
+            if (parsing_index > UINT32_MAX) {
+                return JSON_INCITER_OVERFLOW;
+            }
+            open = container[_JSON_INCITER_TAPE_LINK] & _JSON_INCITER_TAPE_NEXT_MASK;
+            container[_JSON_INCITER_TAPE_END]  = (uint32_t)parsing_index;
+            container[_JSON_INCITER_TAPE_LINK] = ((uint32_t)tag << _JSON_INCITER_TAPE_TAG_SHIFT) | (uint32_t)*entries;
+            parsing_index += _json_inciter_skip_whitespace(&buffer[parsing_index], length - parsing_index);
+        }
+    }
+}
+
+
+/**
+ * @brief Index a NUL terminated json value into a caller provided tape (see `json_inciter_tape_build_n`)
+ *
+ * @param buffer the json string
+ * @param tape caller provided array of `capacity` words, see `JSON_INCITER_TAPE_WORDS`
+ * @param capacity number of words in `tape`
+ * @param entries pointer to be filled with the number of entries written
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_tape_build(const char *buffer, uint32_t *tape, size_t capacity, size_t *entries) {
+    return json_inciter_tape_build_n(buffer, _JSON_INCITER_UNBOUNDED, tape, capacity, entries);
+}
+
+
+/**
+ * @brief index of the entry following the subtree of a tape entry, i.e. its next sibling within its container
+ *
+ * @param tape
+ * @param entry
+ *
+ * @return index of the next entry
+ */
+size_t json_inciter_tape_next(const uint32_t *tape, size_t entry) {
+    return tape[entry * JSON_INCITER_TAPE_ENTRY_WORDS + _JSON_INCITER_TAPE_LINK] & _JSON_INCITER_TAPE_NEXT_MASK;
+}
+
+
+/**
+ * @brief get the element of a tape entry, as `json_inciter_parse_value` would have parsed it (the flags of the
+ * element select its parsing mode)
+ *
+ * @param buffer the json string the tape was built from
+ * @param tape
+ * @param entry
+ * @param element a pointer to the struct to be filled with the element
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_tape_element(const char *buffer, const uint32_t *tape, size_t entry,
+                                         json_inciter_element_t *element) {
+    const uint32_t *words = &tape[entry * JSON_INCITER_TAPE_ENTRY_WORDS];
+
+    element->tag    = (json_inciter_element_tag_t)(words[_JSON_INCITER_TAPE_LINK] >> _JSON_INCITER_TAPE_TAG_SHIFT);
+    element->start  = &buffer[words[_JSON_INCITER_TAPE_OFFSET]];
+    element->length = words[_JSON_INCITER_TAPE_END] - words[_JSON_INCITER_TAPE_OFFSET];
+    element->flags &= (uint8_t)~_JSON_INCITER_FLAG_UNRESOLVED;
+
+    if (element->tag == JSON_INCITER_ELEMENT_TAG_STRING) {
+        element->as.string = element->start + 1;
+    } else if (element->tag == JSON_INCITER_ELEMENT_TAG_NUMBER && !(element->flags & JSON_INCITER_FLAG_LAZY_NUMBERS)) {
+        json_inciter_element_t number = *element;
+        number.flags |= JSON_INCITER_FLAG_LAZY_NUMBERS;
+        return json_inciter_element_as_double(number, &element->as.number);
+    }
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Look for a specific key, of known length, in an object of a tape. The values of the other keys are
+ * skipped in constant time.
+ *
+ * @param buffer the json string the tape was built from
+ * @param tape
+ * @param object entry of the object
+ * @param required_key
+ * @param required_key_len
+ * @param value_entry pointer to be filled with the entry of the value found
+ *
+ * @return JSON_INCITER_OK if found, JSON_INCITER_DONE otherwise, JSON_INCITER_INVALID if the entry is not an object
+ */
+json_inciter_t json_inciter_tape_find_value_in_object_n(const char *buffer, const uint32_t *tape, size_t object,
+                                                        const char *required_key, size_t required_key_len,
+                                                        size_t *value_entry) {
+    const uint32_t *words = &tape[object * JSON_INCITER_TAPE_ENTRY_WORDS];
+    size_t          end   = json_inciter_tape_next(tape, object);
+
+    if ((words[_JSON_INCITER_TAPE_LINK] >> _JSON_INCITER_TAPE_TAG_SHIFT) != JSON_INCITER_ELEMENT_TAG_OBJECT) {
+        return JSON_INCITER_INVALID;
+    }
+
+    // Keys and values alternate, each value being followed by the next key
+    for (size_t key = object + 1; key < end; key = json_inciter_tape_next(tape, key + 1)) {
+        const uint32_t *key_words = &tape[key * JSON_INCITER_TAPE_ENTRY_WORDS];
+        size_t          key_len   = key_words[_JSON_INCITER_TAPE_END] - key_words[_JSON_INCITER_TAPE_OFFSET] - 2;
+
+        if (key_len == required_key_len &&
+            memcmp(&buffer[key_words[_JSON_INCITER_TAPE_OFFSET] + 1], required_key, key_len) == 0) {
+            *value_entry = key + 1;
+            return JSON_INCITER_OK;
+        }
+    }
+
+    return JSON_INCITER_DONE;
+}
+
+
+/**
+ * @brief Look for a specific key in an object of a tape
+ *
+ * @param buffer the json string the tape was built from
+ * @param tape
+ * @param object entry of the object
+ * @param required_key
+ * @param value_entry pointer to be filled with the entry of the value found
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_tape_find_value_in_object(const char *buffer, const uint32_t *tape, size_t object,
+                                                      const char *required_key, size_t *value_entry) {
+    return json_inciter_tape_find_value_in_object_n(buffer, tape, object, required_key, strlen(required_key),
+                                                    value_entry);
+}
+
+
+/**
+ * @brief Resolve a json pointer (RFC 6901) against a tape (see `json_inciter_find_path_n`)
+ *
+ * @param buffer the json string the tape was built from
+ * @param tape
+ * @param path json pointer; the empty string refers to the whole document (entry 0)
+ * @param entry pointer to be filled with the entry found
+ *
+ * @return JSON_INCITER_OK if found, JSON_INCITER_DONE if the path does not exist, JSON_INCITER_INVALID for invalid
+ * pointers
+ */
+json_inciter_t json_inciter_tape_find_path(const char *buffer, const uint32_t *tape, const char *path,
+                                           size_t *entry) {
+    size_t         current   = 0;
+    const char    *token     = NULL;
+    size_t         token_len = 0;
+    json_inciter_t path_result;
+
+    while ((path_result = _json_inciter_pointer_next_token(&path, &token, &token_len)) == JSON_INCITER_OK) {
+        json_inciter_element_tag_t tag =
+            (json_inciter_element_tag_t)(tape[current * JSON_INCITER_TAPE_ENTRY_WORDS + _JSON_INCITER_TAPE_LINK] >>
+                                         _JSON_INCITER_TAPE_TAG_SHIFT);
+        size_t end = json_inciter_tape_next(tape, current);
+
+        if (tag == JSON_INCITER_ELEMENT_TAG_OBJECT) {
+            size_t key = current + 1;
+            for (; key < end; key = json_inciter_tape_next(tape, key + 1)) {
+                const uint32_t *key_words = &tape[key * JSON_INCITER_TAPE_ENTRY_WORDS];
+                if (_json_inciter_pointer_token_equals(
+                        token, token_len, &buffer[key_words[_JSON_INCITER_TAPE_OFFSET] + 1],
+                        key_words[_JSON_INCITER_TAPE_END] - key_words[_JSON_INCITER_TAPE_OFFSET] - 2)) {
+                    break;
+                }
+            }
+            if (key >= end) {
+                return JSON_INCITER_DONE;
+            }
+            current = key + 1;
+        } else if (tag == JSON_INCITER_ELEMENT_TAG_ARRAY) {
+            size_t array_index = 0;
+            if (!_json_inciter_pointer_index(token, token_len, &array_index)) {
+                return JSON_INCITER_DONE;
+            }
+
+            current++;
+            for (; array_index > 0 && current < end; array_index--) {
+                current = json_inciter_tape_next(tape, current);
+            }
+            if (current >= end) {
+                return JSON_INCITER_DONE;
+            }
+        } else {
+            return JSON_INCITER_DONE;
+        }
+    }
+    if (path_result != JSON_INCITER_DONE) {
+        return path_result;
+    }
+
+    *entry = current;
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Hash the keys of an object once into a caller provided open addressing table, so that its members can then
+ * be found with `json_inciter_key_index_find` without walking the object. Keys are compared once unescaped, and only
+ * the first occurrence of a key is kept. The table should have room for about twice as many keys as the object holds.
+ *
+ * @param object
+ * @param slots caller provided table of `n_slots` slots
+ * @param n_slots number of slots
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_OVERFLOW if the table is full (or a key is longer than 4 GiB),
+ * JSON_INCITER_INVALID for invalid json or escape sequences in keys, JSON_INCITER_INCOMPLETE
+ */
+json_inciter_t json_inciter_key_index_build(json_inciter_element_t object, json_inciter_key_slot_t *slots,
+                                            size_t n_slots) {
+    json_inciter_iter_t    iter;
+    json_inciter_element_t key   = _JSON_INCITER_ZERO;
+    json_inciter_element_t value = _JSON_INCITER_ZERO;
+    json_inciter_t         result;
+
+    if (object.tag != JSON_INCITER_ELEMENT_TAG_OBJECT) {
+        return JSON_INCITER_INVALID;
+    } else if (n_slots == 0) {
+        return JSON_INCITER_OVERFLOW;
+    }
+    memset(slots, 0, n_slots * sizeof(*slots));
+
+    json_inciter_iter_init(&iter, object);
+    value.flags = JSON_INCITER_FLAG_LAZY_NUMBERS | JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    while ((result = json_inciter_iter_next(&iter, &key, &value)) == JSON_INCITER_OK) {
+        json_inciter_key_slot_t slot    = _JSON_INCITER_ZERO;
+        const char             *key_str = key.as.string;
+        size_t                  key_len = JSON_INCITER_STRING_LENGTH(key);
+
+        if (key_len > UINT32_MAX) {
+            return JSON_INCITER_OVERFLOW;
+        }
+
+        slot.key        = key_str;
+        slot.key_length = (uint32_t)key_len;
+        slot.escaped    = memchr(key_str, '\\', key_len) != NULL;
+        slot.value      = value.start;
+        if (_json_inciter_key_hash(key_str, key_len, slot.escaped, &slot.hash) != JSON_INCITER_OK) {
+            return JSON_INCITER_INVALID;
+        }
+
+        // Linear probing, the first occurrence of a key is kept
+        size_t index = slot.hash % n_slots;
+        size_t probe = 0;
+        for (; probe < n_slots && slots[index].value != NULL; probe++) {
+            if (slots[index].hash == slot.hash &&
+                _json_inciter_keys_equal(slots[index].key, slots[index].key_length, slots[index].escaped, key_str,
+                                         key_len, slot.escaped)) {
+                break;
+            }
+            index = (index + 1) % n_slots;
+        }
+        if (probe == n_slots) {
+            return JSON_INCITER_OVERFLOW;
+        } else if (slots[index].value == NULL) {
+            slots[index] = slot;
+        }
+    }
+
+    return result == JSON_INCITER_DONE ? JSON_INCITER_OK : result;
+}
+
+
+/**
+ * @brief Look for a precompiled key through the key index of an object, reusing its hash
+ *
+ * @param object the object the index was built from
+ * @param slots table filled by `json_inciter_key_index_build`
+ * @param n_slots number of slots
+ * @param required_key unescaped precompiled key
+ * @param element a pointer to the struct to be filled with the value found, in the parsing mode of the object
+ *
+ * @return JSON_INCITER_OK if found, JSON_INCITER_DONE otherwise
+ */
+json_inciter_t json_inciter_key_index_find_key(json_inciter_element_t object, const json_inciter_key_slot_t *slots,
+                                               size_t n_slots, const json_inciter_key_t *required_key,
+                                               json_inciter_element_t *element) {
+    if (n_slots == 0) {
+        return JSON_INCITER_DONE;
+    }
+
+    size_t index = required_key->hash % n_slots;
+    for (size_t probe = 0; probe < n_slots && slots[index].value != NULL; probe++) {
+        if (slots[index].hash == required_key->hash &&
+            _json_inciter_keys_equal(slots[index].key, slots[index].key_length, slots[index].escaped,
+                                     required_key->key, required_key->length, 0)) {
+            const char *value = slots[index].value;
+            element->flags    = json_inciter_element_flags(object);
+            return json_inciter_parse_value_n(
+                value, _JSON_INCITER_REMAINING(object.length, (size_t)(value - object.start)), element);
+        }
+        index = (index + 1) % n_slots;
+    }
+
+    return JSON_INCITER_DONE;
+}
+
+
+/**
+ * @brief Look for a specific key, of known length, through the key index of an object
+ *
+ * @param object the object the index was built from
+ * @param slots table filled by `json_inciter_key_index_build`
+ * @param n_slots number of slots
+ * @param required_key unescaped key
+ * @param required_key_len
+ * @param element a pointer to the struct to be filled with the value found, in the parsing mode of the object
+ *
+ * @return JSON_INCITER_OK if found, JSON_INCITER_DONE otherwise
+ */
+json_inciter_t json_inciter_key_index_find_n(json_inciter_element_t object, const json_inciter_key_slot_t *slots,
+                                             size_t n_slots, const char *required_key, size_t required_key_len,
+                                             json_inciter_element_t *element) {
+    json_inciter_key_t key = json_inciter_key_make_n(required_key, required_key_len);
+    return json_inciter_key_index_find_key(object, slots, n_slots, &key, element);
+}
+
+
+/**
+ * @brief Look for a specific key through the key index of an object
+ *
+ * @param object the object the index was built from
+ * @param slots table filled by `json_inciter_key_index_build`
+ * @param n_slots number of slots
+ * @param required_key unescaped key
+ * @param element a pointer to the struct to be filled with the value found
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_key_index_find(json_inciter_element_t object, const json_inciter_key_slot_t *slots,
+                                           size_t n_slots, const char *required_key,
+                                           json_inciter_element_t *element) {
+    return json_inciter_key_index_find_n(object, slots, n_slots, required_key, strlen(required_key), element);
+}
+
+
+/**
+ * @brief read a number element as a signed 64 bit integer, without going through floating point
+ *
+ * @param element
+ * @param value pointer to be filled with the integer
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_OVERFLOW if the number does not fit or JSON_INCITER_INVALID if the element
+ * is not an integer number (fractions and exponents are not accepted)
+ */
+json_inciter_t json_inciter_element_as_int64(json_inciter_element_t element, int64_t *value) {
+    uint64_t       magnitude = 0;
+    uint8_t        negative  = 0;
+    json_inciter_t result    = _json_inciter_parse_integer(element, &magnitude, &negative);
+
+    if (result != JSON_INCITER_OK) {
+        return result;
+    } else if (negative && magnitude <= (uint64_t)INT64_MAX + 1) {
+        *value = magnitude == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)magnitude;
+        return JSON_INCITER_OK;
+    } else if (!negative && magnitude <= (uint64_t)INT64_MAX) {
+        *value = (int64_t)magnitude;
+        return JSON_INCITER_OK;
+    } else {
+        return JSON_INCITER_OVERFLOW;
+    }
+}
+
+
+/**
+ * @brief read a number element as an unsigned 64 bit integer, without going through floating point
+ *
+ * @param element
+ * @param value pointer to be filled with the integer
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_OVERFLOW if the number does not fit (negative numbers included) or
+ * JSON_INCITER_INVALID if the element is not an integer number (fractions and exponents are not accepted)
+ */
+json_inciter_t json_inciter_element_as_uint64(json_inciter_element_t element, uint64_t *value) {
+    uint64_t       magnitude = 0;
+    uint8_t        negative  = 0;
+    json_inciter_t result    = _json_inciter_parse_integer(element, &magnitude, &negative);
+
+    if (result != JSON_INCITER_OK) {
+        return result;
+    } else if (negative && magnitude != 0) {
+        return JSON_INCITER_OVERFLOW;
+    } else {
+        *value = magnitude;
+        return JSON_INCITER_OK;
+    }
+}
+
+
+/**
+ * @brief copy the content of a string element into a buffer, decoding its escape sequences (`\\uXXXX` ones, including
+ * surrogate pairs, into UTF-8, lone surrogates becoming U+FFFD). The result is NUL terminated.
+ *
+ * @param destination the buffer to be filled with the content
+ * @param size the size of the buffer
+ * @param element a string element
+ * @param required pointer to be filled with the size needed, NUL terminator included; can be NULL
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_OVERFLOW if the buffer is too small, JSON_INCITER_INVALID if the element is
+ * not a string or holds an invalid escape sequence
+ */
+json_inciter_t json_inciter_copy_string(char *destination, size_t size, json_inciter_element_t element,
+                                        size_t *required) {
+    size_t unescaped_len = 0;
+
+    if (element.tag != JSON_INCITER_ELEMENT_TAG_STRING) {
+        return JSON_INCITER_INVALID;
+    }
+
+    json_inciter_t result = _json_inciter_unescape(element.as.string, JSON_INCITER_STRING_LENGTH(element), destination,
+                                                   size > 0 ? size - 1 : 0, &unescaped_len);
+    if (result != JSON_INCITER_OK) {
+        return result;
+    }
+    if (required != NULL) {
+        *required = unescaped_len + 1;
+    }
+    if (unescaped_len >= size) {
+        return JSON_INCITER_OVERFLOW;
+    }
+
+    destination[unescaped_len] = '\0';
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief decode the escape sequences of a string in place, for mutable buffers. The content is NUL terminated, which
+ * overwrites at most its closing quote.
+ *
+ * @param content the content of a string element, i.e. `(char *)element.as.string`
+ * @param length the length of the content, i.e. `JSON_INCITER_STRING_LENGTH(element)`
+ * @param unescaped_len pointer to be filled with the decoded length
+ *
+ * @return JSON_INCITER_OK, or JSON_INCITER_INVALID for an invalid escape sequence (the content is then left partially
+ * decoded)
+ */
+json_inciter_t json_inciter_unescape_in_place(char *content, size_t length, size_t *unescaped_len) {
+    json_inciter_t result = _json_inciter_unescape(content, length, content, length, unescaped_len);
+    if (result == JSON_INCITER_OK) {
+        content[*unescaped_len] = '\0';
+    }
+    return result;
+}
+
+
+// Store a value in an unsigned integer member of 1, 2, 4 or 8 bytes
+json_inciter_t _json_inciter_store_uint(void *member, size_t size, uint64_t value) {
+    uint8_t  u8  = (uint8_t)value;
+    uint16_t u16 = (uint16_t)value;
+    uint32_t u32 = (uint32_t)value;
+
+    switch (size) {
+        case 1: memcpy(member, &u8, size); return u8 == value ? JSON_INCITER_OK : JSON_INCITER_OVERFLOW;
+        case 2: memcpy(member, &u16, size); return u16 == value ? JSON_INCITER_OK : JSON_INCITER_OVERFLOW;
+        case 4: memcpy(member, &u32, size); return u32 == value ? JSON_INCITER_OK : JSON_INCITER_OVERFLOW;
+        case 8: memcpy(member, &value, size); return JSON_INCITER_OK;
+        default: return JSON_INCITER_INVALID;
+    }
+}
+
+
+// Store a value in a signed integer member of 1, 2, 4 or 8 bytes
+json_inciter_t _json_inciter_store_int(void *member, size_t size, int64_t value) {
+    int8_t  i8  = (int8_t)value;
+    int16_t i16 = (int16_t)value;
+    int32_t i32 = (int32_t)value;
+
+    switch (size) {
+        case 1: memcpy(member, &i8, size); return i8 == value ? JSON_INCITER_OK : JSON_INCITER_OVERFLOW;
+        case 2: memcpy(member, &i16, size); return i16 == value ? JSON_INCITER_OK : JSON_INCITER_OVERFLOW;
+        case 4: memcpy(member, &i32, size); return i32 == value ? JSON_INCITER_OK : JSON_INCITER_OVERFLOW;
+        case 8: memcpy(member, &value, size); return JSON_INCITER_OK;
+        default: return JSON_INCITER_INVALID;
+    }
+}
+
+
+json_inciter_t json_inciter_bind_object(json_inciter_element_t object, const json_inciter_field_t *fields,
+                                        size_t n_fields, void *target, uint32_t *present_mask);
+
+
+// Convert a value found for a descriptor into its member
+json_inciter_t _json_inciter_bind_field(const json_inciter_field_t *field, json_inciter_element_t value, void *member) {
+    json_inciter_t result = JSON_INCITER_OK;
+
+    switch (field->type) {
+        case JSON_INCITER_FIELD_TYPE_INT: {
+            int64_t integer = 0;
+            result          = json_inciter_element_as_int64(value, &integer);
+            return result == JSON_INCITER_OK ? _json_inciter_store_int(member, field->size, integer) : result;
+        }
+
+        case JSON_INCITER_FIELD_TYPE_UINT: {
+            uint64_t integer = 0;
+            result           = json_inciter_element_as_uint64(value, &integer);
+            return result == JSON_INCITER_OK ? _json_inciter_store_uint(member, field->size, integer) : result;
+        }
+
+        case JSON_INCITER_FIELD_TYPE_DOUBLE: {
+            double number = 0;
+            result        = json_inciter_element_as_double(value, &number);
+            if (result != JSON_INCITER_OK) {
+                return result;
+            } else if (field->size == sizeof(float)) {
+                float single = (float)number;
+                memcpy(member, &single, sizeof(single));
+                return JSON_INCITER_OK;
+            } else if (field->size == sizeof(double)) {
+                memcpy(member, &number, sizeof(number));
+                return JSON_INCITER_OK;
+            }
+            return JSON_INCITER_INVALID;
+        }
+
+        case JSON_INCITER_FIELD_TYPE_BOOL:
+            if (value.tag != JSON_INCITER_ELEMENT_TAG_TRUE && value.tag != JSON_INCITER_ELEMENT_TAG_FALSE) {
+                return JSON_INCITER_INVALID;
+            }
+            return _json_inciter_store_uint(member, field->size, value.tag == JSON_INCITER_ELEMENT_TAG_TRUE);
+
+        case JSON_INCITER_FIELD_TYPE_STRING:
+            return json_inciter_copy_string((char *)member, field->size, value, NULL);
+
+        case JSON_INCITER_FIELD_TYPE_ELEMENT:
+            result = json_inciter_element_resolve(&value);
+            if (result == JSON_INCITER_OK) {
+                if (value.tag == JSON_INCITER_ELEMENT_TAG_NUMBER) {
+                    json_inciter_element_as_double(value, &value.as.number);
+                }
+                value.flags = 0;
+                memcpy(member, &value, sizeof(value));
+            }
+            return result;
+
+        case JSON_INCITER_FIELD_TYPE_OBJECT:
+            if (value.tag != JSON_INCITER_ELEMENT_TAG_OBJECT) {
+                return JSON_INCITER_INVALID;
+            }
+            result = json_inciter_bind_object(value, field->fields, field->n_fields, member, NULL);
+            return result == JSON_INCITER_DONE ? JSON_INCITER_OK : result;
+
+        default:
+            return JSON_INCITER_INVALID;
+    }
+}
+
+
+/**
+ * @brief Decode an object into a struct, walking its members once. Each descriptor binds a key to a member of the
+ * struct, converted to the type of the descriptor; keys without descriptor are skipped, as well as `null` values
+ * which leave their member untouched. Nested objects are decoded through their own descriptors.
+ *
+ * @param object
+ * @param fields array of `n_fields` descriptors, see `JSON_INCITER_FIELD`
+ * @param n_fields number of descriptors, at most JSON_INCITER_MAX_KEYS
+ * @param target pointer to the struct to be filled
+ * @param present_mask pointer to be filled with the members set, bit `i` standing for `fields[i]`; can be NULL
+ *
+ * @return JSON_INCITER_OK if every member was set, JSON_INCITER_DONE if some were not, JSON_INCITER_INVALID if a
+ * value does not have the type of its member, JSON_INCITER_OVERFLOW if it does not fit, or the parsing error
+ */
+json_inciter_t json_inciter_bind_object(json_inciter_element_t object, const json_inciter_field_t *fields,
+                                        size_t n_fields, void *target, uint32_t *present_mask) {
+    json_inciter_key_t     keys[JSON_INCITER_MAX_KEYS] = {_JSON_INCITER_ZERO};
+    json_inciter_element_t values[JSON_INCITER_MAX_KEYS];
+    json_inciter_element_t lazy_object                  = object;
+    uint32_t               found                        = 0;
+    uint32_t               present                      = 0;
+    uint32_t               all_found                    = 0;
+
+    if (present_mask != NULL) {
+        *present_mask = 0;
+    }
+    if (n_fields > JSON_INCITER_MAX_KEYS) {
+        return JSON_INCITER_INVALID;
+    }
+
+    memset(values, 0, sizeof(values));
+    for (size_t i = 0; i < n_fields; i++) {
+        keys[i] = _json_inciter_key_make_unhashed(fields[i].key, fields[i].key_length);
+        all_found |= (uint32_t)1 << i;
+    }
+
+    // Found values take the mode of the object: numbers are left to the conversion of their member
+    lazy_object.flags |= JSON_INCITER_FLAG_LAZY_NUMBERS;
+    json_inciter_t result = json_inciter_find_keys_in_object(lazy_object, keys, n_fields, values, &found);
+    if (result != JSON_INCITER_OK && result != JSON_INCITER_DONE) {
+        return result;
+    }
+
+    for (size_t i = 0; i < n_fields; i++) {
+        if (!(found & ((uint32_t)1 << i)) || values[i].tag == JSON_INCITER_ELEMENT_TAG_NULL) {
+            continue;
+        }
+
+        result = _json_inciter_bind_field(&fields[i], values[i], (char *)target + fields[i].offset);
+        if (result != JSON_INCITER_OK) {
+            return result;
+        }
+        present |= (uint32_t)1 << i;
+        if (present_mask != NULL) {
+            *present_mask = present;
+        }
+    }
+
+    return present == all_found ? JSON_INCITER_OK : JSON_INCITER_DONE;
+}
+
+
+/**
+ * @brief copy the content of the element into a buffer, as found in the json stream (see `json_inciter_copy_string`
+ * to decode escape sequences). The end of a lazy container is found on the copy passed in; use
+ * `json_inciter_element_resolve` beforehand to keep it in the caller's element.
+ *
+ * @param content_buffer the buffer to be filled with the content
+ * @param max_len the size of the buffer
+ * @param element
+ *
+ * @return 0 if successful (i.e. the buffer size was sufficient to hold the content), -1 otherwise
+ */
+uint8_t json_inciter_copy_content(char *content_buffer, size_t max_len, json_inciter_element_t element) {
+    size_t      len   = 0;
+    const char *start = NULL;
+
+    if (json_inciter_element_resolve(&element) != JSON_INCITER_OK) {
+        return -1;
+    }
+
+    if (element.tag == JSON_INCITER_ELEMENT_TAG_STRING) {
+        len   = JSON_INCITER_STRING_LENGTH(element);
+        start = element.as.string;
+    } else {
+        len   = element.length;
+        start = element.start;
+    }
+
+    if (len < max_len) {
+        memcpy(content_buffer, start, len);
+        content_buffer[len] = '\0';
+        return 0;
+    } else {
+        return -1;
+    }
+}
+
+
+/*
+ * Writer
+ */
+
+// Floating point number with a 64 bit significand, `f * 2^e`, for the shortest formatting of doubles
+typedef struct {
+    uint64_t f;
+    int      e;
+} _json_inciter_diyfp_t;
+
+
+// Product of two numbers, the significand being rounded to 64 bits
+_json_inciter_diyfp_t _json_inciter_diyfp_mul(_json_inciter_diyfp_t x, _json_inciter_diyfp_t y) {
+    uint64_t low_low   = (x.f & 0xFFFFFFFFu) * (y.f & 0xFFFFFFFFu);
+    uint64_t low_high  = (x.f & 0xFFFFFFFFu) * (y.f >> 32);
+    uint64_t high_low  = (x.f >> 32) * (y.f & 0xFFFFFFFFu);
+    uint64_t high_high = (x.f >> 32) * (y.f >> 32);
+    uint64_t middle    = (low_low >> 32) + (low_high & 0xFFFFFFFFu) + (high_low & 0xFFFFFFFFu) + ((uint64_t)1 << 31);
+
+    _json_inciter_diyfp_t product = {high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32), x.e + y.e + 64};
+    return product;
+}
+
+
+// Shift the significand until its highest bit is set
+_json_inciter_diyfp_t _json_inciter_diyfp_normalize(_json_inciter_diyfp_t x) {
+    while (!(x.f >> 63)) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+
+// Cached power of ten `c ~= 10^-k` such that the product of a normalized number of binary exponent `e` by it has a
+// binary exponent between -60 and -32, leaving room for the digit generation
+_json_inciter_diyfp_t _json_inciter_cached_power(int e, int *k) {
+    // 10^k ~= f * 2^e, for k from -300 to 324 in steps of 8
+    static const struct {
+        uint64_t f;
+        int16_t  e;
+        int16_t  k;
+    } powers[] = {
+        {0xAB70FE17C79AC6CAULL, -1060, -300}, {0xFF77B1FCBEBCDC4FULL, -1034, -292},
+        {0xBE5691EF416BD60CULL, -1007, -284}, {0x8DD01FAD907FFC3CULL, -980, -276}, {0xD3515C2831559A83ULL, -954, -268},
+        {0x9D71AC8FADA6C9B5ULL, -927, -260}, {0xEA9C227723EE8BCBULL, -901, -252}, {0xAECC49914078536DULL, -874, -244},
+        {0x823C12795DB6CE57ULL, -847, -236}, {0xC21094364DFB5637ULL, -821, -228}, {0x9096EA6F3848984FULL, -794, -220},
+        {0xD77485CB25823AC7ULL, -768, -212}, {0xA086CFCD97BF97F4ULL, -741, -204}, {0xEF340A98172AACE5ULL, -715, -196},
+        {0xB23867FB2A35B28EULL, -688, -188}, {0x84C8D4DFD2C63F3BULL, -661, -180}, {0xC5DD44271AD3CDBAULL, -635, -172},
+        {0x936B9FCEBB25C996ULL, -608, -164}, {0xDBAC6C247D62A584ULL, -582, -156}, {0xA3AB66580D5FDAF6ULL, -555, -148},
+        {0xF3E2F893DEC3F126ULL, -529, -140}, {0xB5B5ADA8AAFF80B8ULL, -502, -132}, {0x87625F056C7C4A8BULL, -475, -124},
+        {0xC9BCFF6034C13053ULL, -449, -116}, {0x964E858C91BA2655ULL, -422, -108}, {0xDFF9772470297EBDULL, -396, -100},
+        {0xA6DFBD9FB8E5B88FULL, -369, -92}, {0xF8A95FCF88747D94ULL, -343, -84}, {0xB94470938FA89BCFULL, -316, -76},
+        {0x8A08F0F8BF0F156BULL, -289, -68}, {0xCDB02555653131B6ULL, -263, -60}, {0x993FE2C6D07B7FACULL, -236, -52},
+        {0xE45C10C42A2B3B06ULL, -210, -44}, {0xAA242499697392D3ULL, -183, -36}, {0xFD87B5F28300CA0EULL, -157, -28},
+        {0xBCE5086492111AEBULL, -130, -20}, {0x8CBCCC096F5088CCULL, -103, -12}, {0xD1B71758E219652CULL, -77, -4},
+        {0x9C40000000000000ULL, -50, 4}, {0xE8D4A51000000000ULL, -24, 12}, {0xAD78EBC5AC620000ULL, 3, 20},
+        {0x813F3978F8940984ULL, 30, 28}, {0xC097CE7BC90715B3ULL, 56, 36}, {0x8F7E32CE7BEA5C70ULL, 83, 44},
+        {0xD5D238A4ABE98068ULL, 109, 52}, {0x9F4F2726179A2245ULL, 136, 60}, {0xED63A231D4C4FB27ULL, 162, 68},
+        {0xB0DE65388CC8ADA8ULL, 189, 76}, {0x83C7088E1AAB65DBULL, 216, 84}, {0xC45D1DF942711D9AULL, 242, 92},
+        {0x924D692CA61BE758ULL, 269, 100}, {0xDA01EE641A708DEAULL, 295, 108}, {0xA26DA3999AEF774AULL, 322, 116},
+        {0xF209787BB47D6B85ULL, 348, 124}, {0xB454E4A179DD1877ULL, 375, 132}, {0x865B86925B9BC5C2ULL, 402, 140},
+        {0xC83553C5C8965D3DULL, 428, 148}, {0x952AB45CFA97A0B3ULL, 455, 156}, {0xDE469FBD99A05FE3ULL, 481, 164},
+        {0xA59BC234DB398C25ULL, 508, 172}, {0xF6C69A72A3989F5CULL, 534, 180}, {0xB7DCBF5354E9BECEULL, 561, 188},
+        {0x88FCF317F22241E2ULL, 588, 196}, {0xCC20CE9BD35C78A5ULL, 614, 204}, {0x98165AF37B2153DFULL, 641, 212},
+        {0xE2A0B5DC971F303AULL, 667, 220}, {0xA8D9D1535CE3B396ULL, 694, 228}, {0xFB9B7CD9A4A7443CULL, 720, 236},
+        {0xBB764C4CA7A44410ULL, 747, 244}, {0x8BAB8EEFB6409C1AULL, 774, 252}, {0xD01FEF10A657842CULL, 800, 260},
+        {0x9B10A4E5E9913129ULL, 827, 268}, {0xE7109BFBA19C0C9DULL, 853, 276}, {0xAC2820D9623BF429ULL, 880, 284},
+        {0x80444B5E7AA7CF85ULL, 907, 292}, {0xBF21E44003ACDD2DULL, 933, 300}, {0x8E679C2F5E44FF8FULL, 960, 308},
+        {0xD433179D9C8CB841ULL, 986, 316}, {0x9E19DB92B4E31BA9ULL, 1013, 324},
+    };
+
+    // Smallest k such that 10^k * 2^e >= 2^-61, then the cached power that follows it
+    int                   f      = -60 - e - 1;
+    int                   exact  = f * 78913 / (1 << 18) + (f > 0);
+    size_t                index  = (size_t)((300 + exact + 7) / 8);
+    _json_inciter_diyfp_t cached = {powers[index].f, powers[index].e};
+
+    *k = powers[index].k;
+    return cached;
+}
+
+
+// Move the last digit towards the scaled value, `distance` below the top of the unsafe interval, while the digits
+// stay within it; 0 when the digits cannot be proven to be the closest shortest ones to within `unit`, the error of
+// the scaling
+uint8_t _json_inciter_grisu_round(char *digits, size_t length, uint64_t distance, uint64_t unsafe, uint64_t rest,
+                                  uint64_t ten_k, uint64_t unit) {
+    uint64_t small_distance = distance - unit;
+    uint64_t big_distance   = distance + unit;
+
+    while (rest < small_distance && unsafe - rest >= ten_k &&
+           (rest + ten_k < small_distance || small_distance - rest >= rest + ten_k - small_distance)) {
+        digits[length - 1]--;
+        rest += ten_k;
+    }
+    // Moving further would get closer to some value of the error range: undecided
+    if (rest < big_distance && unsafe - rest >= ten_k &&
+        (rest + ten_k < big_distance || big_distance - rest > rest + ten_k - big_distance)) {
+        return 0;
+    }
+    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+}
+
+
+/**
+ * Shortest digits of a positive double that read back to it (Grisu3, by Florian Loitsch): the bounds of the interval
+ * of the numbers rounding to the double are scaled by a cached power of ten, widened by the error of the scaling, and
+ * digits are generated until the remainder fits the interval. The result is `digits * 10^exponent`, with up to 17
+ * digits, or 0 digits for the doubles (about 0.5%) whose shortest digits cannot be told apart from the error.
+ */
+size_t _json_inciter_grisu3(double value, char *digits, int *exponent) {
+    const uint64_t hidden_bit = (uint64_t)1 << 52;
+
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t fraction = bits & (hidden_bit - 1);
+    int      biased   = (int)(bits >> 52);
+
+    // Value, then the bounds of its rounding interval, closer below powers of two
+    _json_inciter_diyfp_t v     = {biased == 0 ? fraction : fraction | hidden_bit, (biased == 0 ? 1 : biased) - 1075};
+    _json_inciter_diyfp_t plus  = {2 * v.f + 1, v.e - 1};
+    _json_inciter_diyfp_t minus = {2 * v.f - 1, v.e - 1};
+    if (fraction == 0 && biased > 1) {
+        minus.f = 4 * v.f - 1;
+        minus.e = v.e - 2;
+    }
+    plus    = _json_inciter_diyfp_normalize(plus);
+    minus.f = minus.f << (minus.e - plus.e);
+    minus.e = plus.e;
+    v       = _json_inciter_diyfp_normalize(v);
+
+    // Scaled so that the integral part fits 32 bits, the bounds widened by the error of the scaling: every digit
+    // sequence outside of them is certain not to read back
+    int                   k      = 0;
+    _json_inciter_diyfp_t cached = _json_inciter_cached_power(plus.e, &k);
+    _json_inciter_diyfp_t w      = _json_inciter_diyfp_mul(v, cached);
+    _json_inciter_diyfp_t low    = _json_inciter_diyfp_mul(minus, cached);
+    _json_inciter_diyfp_t high   = _json_inciter_diyfp_mul(plus, cached);
+    uint64_t              unit   = 1;
+    low.f -= unit;
+    high.f += unit;
+
+    uint64_t unsafe     = high.f - low.f;
+    uint64_t distance   = high.f - w.f;
+    int      shift      = -high.e;
+    uint64_t one        = (uint64_t)1 << shift;
+    uint32_t integral   = (uint32_t)(high.f >> shift);
+    uint64_t fractional = high.f & (one - 1);
+    uint32_t power      = 1;
+    int      n          = 1;
+    size_t   length     = 0;
+
+    *exponent = -k;
+    while (integral / power >= 10) {
+        power *= 10;
+        n++;
+    }
+
+    // Digits of the integral part
+    while (n > 0) {
+        digits[length++] = (char)('0' + integral / power);
+        integral %= power;
+        n--;
+
+        uint64_t rest = ((uint64_t)integral << shift) + fractional;
+        if (rest < unsafe) {
+            *exponent += n;
+            return _json_inciter_grisu_round(digits, length, distance, unsafe, rest, (uint64_t)power << shift, unit)
+                       ? length
+                       : 0;
+        }
+        power /= 10;
+    }
+
+    // Digits of the fractional part
+    for (;;) {
+        fractional *= 10;
+        unit *= 10;
+        unsafe *= 10;
+        digits[length++] = (char)('0' + (fractional >> shift));
+        fractional &= one - 1;
+        (*exponent)--;
+        if (fractional < unsafe) {
+            break;
+        }
+    }
+    return _json_inciter_grisu_round(digits, length, distance * unit, unsafe, fractional, one, unit) ? length : 0;
+}
+
+
+// Decimal digits of an integer into `buffer` (20 bytes at least), returning their number
+size_t _json_inciter_format_uint64(char *buffer, uint64_t value) {
+    char   reversed[20];
+    size_t length = 0;
+    size_t i      = 0;
+
+    do {
+        reversed[length++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    for (i = 0; i < length; i++) {
+        buffer[i] = reversed[length - 1 - i];
+    }
+    return length;
+}
+
+
+// Shortest digits of a positive double for the ones Grisu3 leaves undecided: the double rounded to more and more digits
+// by snprintf, and the neighbours of the rounded digits as the rounding interval is lopsided at powers of two, until
+// strtod reads one of them back. Digits are printed and read without a decimal point, so the locale does not matter.
+size_t _json_inciter_shortest_digits(double value, char *digits, int *exponent) {
+    char   printed[48];
+    size_t length = 0;
+
+    for (int precision = 1; precision <= 17; precision++) {
+        unsigned long long significand = 0;
+        const char        *c           = printed;
+
+        snprintf(printed, sizeof(printed), "%.*e", precision - 1, value);
+        for (; *c != 'e'; c++) {
+            significand = IS_DIGIT(*c) ? significand * 10 + (unsigned long long)(*c - '0') : significand;
+        }
+        int decimal = atoi(c + 1) - (precision - 1);
+
+        unsigned long long candidates[3] = {significand, significand + 1, significand - 1};
+        for (size_t i = 0; i < 3; i++) {
+            snprintf(printed, sizeof(printed), "%llue%d", candidates[i], decimal);
+            if (strtod(printed, NULL) == value) {
+                length    = _json_inciter_format_uint64(digits, candidates[i]);
+                *exponent = decimal;
+                while (digits[length - 1] == '0') {
+                    length--;
+                    (*exponent)++;
+                }
+                return length;
+            }
+        }
+    }
+    return length;
+}
+
+
+// Shortest json number that reads back to a finite double into `buffer` (32 bytes at least), returning its length.
+// Exponents are used below 10^-4 and from 10^16.
+size_t _json_inciter_format_double(char *buffer, double value) {
+    char   digits[20];
+    int    exponent = 0;
+    size_t length   = 0;
+
+    if (value < 0 || (value == 0 && 1 / value < 0)) {
+        buffer[length++] = '-';
+        value            = -value;
+    }
+    if (value == 0) {
+        buffer[length++] = '0';
+        return length;
+    }
+
+    int n_digits = (int)_json_inciter_grisu3(value, digits, &exponent);
+    if (n_digits == 0) {
+        n_digits = (int)_json_inciter_shortest_digits(value, digits, &exponent);
+    }
+    int point    = n_digits + exponent;     // Position of the decimal point in the digits
+
+    if (n_digits <= point && point <= 16) {
+        memcpy(&buffer[length], digits, (size_t)n_digits);
+        memset(&buffer[length + (size_t)n_digits], '0', (size_t)(point - n_digits));
+        return length + (size_t)point;
+    } else if (0 < point && point <= 16) {
+        memcpy(&buffer[length], digits, (size_t)point);
+        buffer[length + (size_t)point] = '.';
+        memcpy(&buffer[length + (size_t)point + 1], &digits[point], (size_t)(n_digits - point));
+        return length + (size_t)n_digits + 1;
+    } else if (-4 < point && point <= 0) {
+        buffer[length++] = '0';
+        buffer[length++] = '.';
+        memset(&buffer[length], '0', (size_t)-point);
+        memcpy(&buffer[length + (size_t)-point], digits, (size_t)n_digits);
+        return length + (size_t)(n_digits - point);
+    }
+
+    buffer[length++] = digits[0];
+    if (n_digits > 1) {
+        buffer[length++] = '.';
+        memcpy(&buffer[length], &digits[1], (size_t)(n_digits - 1));
+        length += (size_t)(n_digits - 1);
+    }
+    buffer[length++] = 'e';
+    if (point - 1 < 0) {
+        buffer[length++] = '-';
+    }
+    return length + _json_inciter_format_uint64(&buffer[length], (uint64_t)(point - 1 < 0 ? 1 - point : point - 1));
+}
+
+
+// Offset of the first character of a span that must be escaped in a json string (quote, backslash or control
+// character), `length` if there is none
+size_t _json_inciter_find_unsafe(const char *buffer, size_t length) {
+    size_t index = 0;
+
+#if defined(_JSON_INCITER_SIMD_AVX2)
+    for (; length - index >= 32; index += 32) {
+        __m256i  bytes   = _mm256_loadu_si256((const __m256i *)&buffer[index]);
+        __m256i  control = _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, _mm256_set1_epi8(0x1F)), bytes);
+        __m256i  special = _mm256_or_si256(control, _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')),
+                                                                    _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))));
+        uint32_t mask    = (uint32_t)_mm256_movemask_epi8(special);
+        if (mask != 0) {
+            return index + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif
+#if defined(_JSON_INCITER_SIMD_SSE2)
+    for (; length - index >= 16; index += 16) {
+        __m128i  bytes   = _mm_loadu_si128((const __m128i *)&buffer[index]);
+        __m128i  control = _mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(0x1F)), bytes);
+        __m128i  special = _mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')),
+                                                              _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))));
+        uint32_t mask    = (uint32_t)_mm_movemask_epi8(special);
+        if (mask != 0) {
+            return index + (size_t)__builtin_ctz(mask);
+        }
+    }
+#elif defined(_JSON_INCITER_SIMD_NEON)
+    for (; length - index >= 16; index += 16) {
+        uint8x16_t bytes   = vld1q_u8((const uint8_t *)&buffer[index]);
+        uint8x16_t special = vorrq_u8(vcltq_u8(bytes, vdupq_n_u8(0x20)),
+                                      vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('"')), vceqq_u8(bytes, vdupq_n_u8('\\'))));
+        uint32_t   mask    = _json_inciter_neon_movemask(special);
+        if (mask != 0) {
+            return index + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif
+
+    while (index < length && (unsigned char)buffer[index] >= 0x20 && buffer[index] != '"' && buffer[index] != '\\') {
+        index++;
+    }
+    return index;
+}
+
+
+// Hand the buffered output to the flush callback
+json_inciter_t _json_inciter_writer_drain(json_inciter_writer_t *writer) {
+    if (writer->used > 0 && writer->error == JSON_INCITER_OK) {
+        writer->error = writer->flush(writer->context, writer->buffer, writer->used);
+        writer->used  = 0;
+    }
+    return writer->error;
+}
+
+
+// Append bytes to the output, flushing the buffer when they do not fit; runs longer than the buffer go straight to
+// the callback
+json_inciter_t _json_inciter_writer_put(json_inciter_writer_t *writer, const char *data, size_t length) {
+    if (length <= writer->size - writer->used) {
+        memcpy(&writer->buffer[writer->used], data, length);
+        writer->used += length;
+        return JSON_INCITER_OK;
+    } else if (writer->flush == NULL) {
+        writer->error = JSON_INCITER_OVERFLOW;
+        return writer->error;
+    } else if (_json_inciter_writer_drain(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (length >= writer->size) {
+        writer->error = writer->flush(writer->context, data, length);
+        return writer->error;
+    }
+
+    memcpy(writer->buffer, data, length);
+    writer->used = length;
+    return JSON_INCITER_OK;
+}
+
+
+// Whether the innermost container is an object
+#define _JSON_INCITER_WRITER_IN_OBJECT(Writer)                                                                         \
+    ((Writer)->depth > 0 && ((Writer)->objects[((Writer)->depth - 1) / 8] >> (((Writer)->depth - 1) % 8)) & 1)
+
+
+// Check that a value can be written and write the separator in front of it: a comma between members, a newline
+// between values at the root
+json_inciter_t _json_inciter_writer_value(json_inciter_writer_t *writer) {
+    if (writer->error != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (writer->state & _JSON_INCITER_WRITER_KEY) {
+        writer->state = _JSON_INCITER_WRITER_MEMBER;
+        return JSON_INCITER_OK;
+    } else if (_JSON_INCITER_WRITER_IN_OBJECT(writer)) {
+        writer->error = JSON_INCITER_INVALID;
+        return writer->error;
+    } else if (writer->state & _JSON_INCITER_WRITER_MEMBER) {
+        writer->state = _JSON_INCITER_WRITER_MEMBER;
+        return _json_inciter_writer_put(writer, writer->depth > 0 ? "," : "\n", 1);
+    }
+    writer->state = _JSON_INCITER_WRITER_MEMBER;
+    return JSON_INCITER_OK;
+}
+
+
+// Write content as a quoted json string, escaping quotes, backslashes and control characters
+json_inciter_t _json_inciter_writer_quoted(json_inciter_writer_t *writer, const char *content, size_t length) {
+    size_t index = 0;
+
+    _json_inciter_writer_put(writer, "\"", 1);
+    while (writer->error == JSON_INCITER_OK) {
+        size_t run = _json_inciter_find_unsafe(&content[index], length - index);
+        if (_json_inciter_writer_put(writer, &content[index], run) != JSON_INCITER_OK || index + run == length) {
+            break;
+        }
+        index += run;
+
+        char          escape[6] = {'\\', 'u', '0', '0', '0', '0'};
+        unsigned char character = (unsigned char)content[index++];
+        size_t        escape_len = 2;
+        switch (character) {
+            case '"': escape[1] = '"'; break;
+            case '\\': escape[1] = '\\'; break;
+            case '\b': escape[1] = 'b'; break;
+            case '\f': escape[1] = 'f'; break;
+            case '\n': escape[1] = 'n'; break;
+            case '\r': escape[1] = 'r'; break;
+            case '\t': escape[1] = 't'; break;
+            default:
+                escape[4]  = (char)('0' + (character >> 4));
+                escape[5]  = "0123456789abcdef"[character & 0x0F];
+                escape_len = 6;
+                break;
+        }
+        _json_inciter_writer_put(writer, escape, escape_len);
+    }
+    return writer->error == JSON_INCITER_OK ? _json_inciter_writer_put(writer, "\"", 1) : writer->error;
+}
+
+
+// Open a container
+json_inciter_t _json_inciter_writer_begin(json_inciter_writer_t *writer, uint8_t object) {
+    if (_json_inciter_writer_value(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (writer->depth >= JSON_INCITER_MAX_DEPTH) {
+        writer->error = JSON_INCITER_OVERFLOW;
+        return writer->error;
+    }
+
+    uint8_t bit = (uint8_t)(1u << (writer->depth % 8));
+    writer->objects[writer->depth / 8] =
+        (uint8_t)(object ? writer->objects[writer->depth / 8] | bit : writer->objects[writer->depth / 8] & ~bit);
+    writer->depth++;
+    writer->state = 0;
+    return _json_inciter_writer_put(writer, object ? "{" : "[", 1);
+}
+
+
+// Close the innermost container, which must be of the given kind and not wait for the value of a key
+json_inciter_t _json_inciter_writer_end(json_inciter_writer_t *writer, uint8_t object) {
+    if (writer->error != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (writer->depth == 0 || (uint8_t)_JSON_INCITER_WRITER_IN_OBJECT(writer) != object ||
+               (writer->state & _JSON_INCITER_WRITER_KEY)) {
+        writer->error = JSON_INCITER_INVALID;
+        return writer->error;
+    }
+
+    writer->depth--;
+    writer->state = _JSON_INCITER_WRITER_MEMBER;
+    return _json_inciter_writer_put(writer, object ? "}" : "]", 1);
+}
+
+
+/**
+ * @brief Prepare to write json into a buffer. Values written at the root are separated by newlines (NDJSON).
+ *
+ * @param writer the writer to initialize
+ * @param buffer the output
+ * @param size the size of the buffer; with a flush callback, it only needs to hold the longest number
+ * (32 bytes) and runs longer than the buffer are handed to the callback directly
+ * @param flush called with the output when the buffer is full and by `json_inciter_writer_flush`; NULL to keep
+ * the whole output in the buffer, writes failing with JSON_INCITER_OVERFLOW when it is full
+ * @param context passed to `flush`
+ */
+void json_inciter_writer_init(json_inciter_writer_t *writer, char *buffer, size_t size,
+                              json_inciter_flush_callback_t flush, void *context) {
+    writer->buffer  = buffer;
+    writer->size    = size;
+    writer->used    = 0;
+    writer->flush   = flush;
+    writer->context = context;
+    writer->error   = JSON_INCITER_OK;
+    writer->depth   = 0;
+    writer->state   = 0;
+}
+
+
+/**
+ * @brief Hand the buffered output to the flush callback, if any (without one, the output stays in the buffer, `used`
+ * bytes long)
+ *
+ * @param writer
+ *
+ * @return JSON_INCITER_OK, or the first error of the writer
+ */
+json_inciter_t json_inciter_writer_flush(json_inciter_writer_t *writer) {
+    return writer->flush != NULL ? _json_inciter_writer_drain(writer) : writer->error;
+}
+
+
+/**
+ * @brief Open an object
+ *
+ * @param writer
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID where a key is expected, JSON_INCITER_OVERFLOW past
+ * JSON_INCITER_MAX_DEPTH levels or when the output does not fit, or the first error of the writer
+ */
+json_inciter_t json_inciter_write_begin_object(json_inciter_writer_t *writer) {
+    return _json_inciter_writer_begin(writer, 1);
+}
+
+
+/**
+ * @brief Close the innermost object
+ *
+ * @param writer
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID if the innermost container is not an object or waits for the value of
+ * a key, JSON_INCITER_OVERFLOW when the output does not fit, or the first error of the writer
+ */
+json_inciter_t json_inciter_write_end_object(json_inciter_writer_t *writer) {
+    return _json_inciter_writer_end(writer, 1);
+}
+
+
+/**
+ * @brief Open an array
+ *
+ * @param writer
+ *
+ * @return result, as for `json_inciter_write_begin_object`
+ */
+json_inciter_t json_inciter_write_begin_array(json_inciter_writer_t *writer) {
+    return _json_inciter_writer_begin(writer, 0);
+}
+
+
+/**
+ * @brief Close the innermost array
+ *
+ * @param writer
+ *
+ * @return result, as for `json_inciter_write_end_object`
+ */
+json_inciter_t json_inciter_write_end_array(json_inciter_writer_t *writer) {
+    return _json_inciter_writer_end(writer, 0);
+}
+
+
+/**
+ * @brief Write the key of an object member, escaping it, before its value
+ *
+ * @param writer
+ * @param key
+ * @param length
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID outside of an object or after another key, JSON_INCITER_OVERFLOW
+ * when the output does not fit, or the first error of the writer
+ */
+json_inciter_t json_inciter_write_key_n(json_inciter_writer_t *writer, const char *key, size_t length) {
+    if (writer->error != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (!_JSON_INCITER_WRITER_IN_OBJECT(writer) || (writer->state & _JSON_INCITER_WRITER_KEY)) {
+        writer->error = JSON_INCITER_INVALID;
+        return writer->error;
+    } else if (writer->state & _JSON_INCITER_WRITER_MEMBER) {
+        _json_inciter_writer_put(writer, ",", 1);
+    }
+
+    writer->state = _JSON_INCITER_WRITER_KEY;
+    _json_inciter_writer_quoted(writer, key, length);
+    return writer->error == JSON_INCITER_OK ? _json_inciter_writer_put(writer, ":", 1) : writer->error;
+}
+
+
+/**
+ * @brief Write the NUL terminated key of an object member, see `json_inciter_write_key_n`
+ *
+ * @param writer
+ * @param key
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_write_key(json_inciter_writer_t *writer, const char *key) {
+    return json_inciter_write_key_n(writer, key, strlen(key));
+}
+
+
+/**
+ * @brief Write a string, escaping quotes, backslashes and control characters (found a vector at a time); other bytes,
+ * UTF-8 included, are written as they are
+ *
+ * @param writer
+ * @param content
+ * @param length
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID where a key is expected, JSON_INCITER_OVERFLOW when the output does
+ * not fit, or the first error of the writer
+ */
+json_inciter_t json_inciter_write_string_n(json_inciter_writer_t *writer, const char *content, size_t length) {
+    if (_json_inciter_writer_value(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    }
+    return _json_inciter_writer_quoted(writer, content, length);
+}
+
+
+/**
+ * @brief Write a NUL terminated string, see `json_inciter_write_string_n`
+ *
+ * @param writer
+ * @param content
+ *
+ * @return result
+ */
+json_inciter_t json_inciter_write_string(json_inciter_writer_t *writer, const char *content) {
+    return json_inciter_write_string_n(writer, content, strlen(content));
+}
+
+
+/**
+ * @brief Write a signed integer
+ *
+ * @param writer
+ * @param value
+ *
+ * @return result, as for `json_inciter_write_string_n`
+ */
+json_inciter_t json_inciter_write_int64(json_inciter_writer_t *writer, int64_t value) {
+    char   number[21];
+    size_t length = 0;
+
+    if (_json_inciter_writer_value(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (value < 0) {
+        number[length++] = '-';
+    }
+    length += _json_inciter_format_uint64(&number[length], value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value);
+    return _json_inciter_writer_put(writer, number, length);
+}
+
+
+/**
+ * @brief Write an unsigned integer
+ *
+ * @param writer
+ * @param value
+ *
+ * @return result, as for `json_inciter_write_string_n`
+ */
+json_inciter_t json_inciter_write_uint64(json_inciter_writer_t *writer, uint64_t value) {
+    char number[20];
+
+    if (_json_inciter_writer_value(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    }
+    return _json_inciter_writer_put(writer, number, _json_inciter_format_uint64(number, value));
+}
+
+
+/**
+ * @brief Write a double with the fewest digits that read back to it (Grisu3, with `snprintf` and `strtod` for the
+ * doubles it cannot decide), whatever the locale
+ *
+ * @param writer
+ * @param value
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID for infinities and NaNs, which json cannot represent (nothing is
+ * written and the writer can go on), or as for `json_inciter_write_string_n`
+ */
+json_inciter_t json_inciter_write_double(json_inciter_writer_t *writer, double value) {
+    char number[32];
+
+    if (writer->error != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (value != value || value - value != 0) {
+        return JSON_INCITER_INVALID;
+    } else if (_json_inciter_writer_value(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    }
+    return _json_inciter_writer_put(writer, number, _json_inciter_format_double(number, value));
+}
+
+
+/**
+ * @brief Write `true` or `false`
+ *
+ * @param writer
+ * @param value
+ *
+ * @return result, as for `json_inciter_write_string_n`
+ */
+json_inciter_t json_inciter_write_bool(json_inciter_writer_t *writer, uint8_t value) {
+    if (_json_inciter_writer_value(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    }
+    return value ? _json_inciter_writer_put(writer, "true", 4) : _json_inciter_writer_put(writer, "false", 5);
+}
+
+
+/**
+ * @brief Write `null`
+ *
+ * @param writer
+ *
+ * @return result, as for `json_inciter_write_string_n`
+ */
+json_inciter_t json_inciter_write_null(json_inciter_writer_t *writer) {
+    if (_json_inciter_writer_value(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    }
+    return _json_inciter_writer_put(writer, "null", 4);
+}
+
+
+/**
+ * @brief Write a parsed element as found in its json stream, without encoding it again: values are forwarded with
+ * a single copy. The end of a lazy container is found on the copy passed in.
+ *
+ * @param writer
+ * @param element any value
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID or JSON_INCITER_INCOMPLETE if the end of a lazy container cannot be
+ * found (nothing is written and the writer can go on), or as for `json_inciter_write_string_n`
+ */
+json_inciter_t json_inciter_write_element(json_inciter_writer_t *writer, json_inciter_element_t element) {
+    json_inciter_t result = json_inciter_element_resolve(&element);
+
+    if (writer->error != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (result != JSON_INCITER_OK) {
+        return result;
+    } else if (_json_inciter_writer_value(writer) != JSON_INCITER_OK) {
+        return writer->error;
+    }
+    return _json_inciter_writer_put(writer, element.start, element.length);
+}
+
+
+/**
+ * @brief Write a parsed string element as the key of an object member, as found in its json stream (escape
+ * sequences included)
+ *
+ * @param writer
+ * @param key a string element, e.g. a key returned by `json_inciter_iter_next`
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID if the element is not a string (nothing is written and the writer can
+ * go on), or as for `json_inciter_write_key_n`
+ */
+json_inciter_t json_inciter_write_key_element(json_inciter_writer_t *writer, json_inciter_element_t key) {
+    if (writer->error != JSON_INCITER_OK) {
+        return writer->error;
+    } else if (key.tag != JSON_INCITER_ELEMENT_TAG_STRING) {
+        return JSON_INCITER_INVALID;
+    } else if (!_JSON_INCITER_WRITER_IN_OBJECT(writer) || (writer->state & _JSON_INCITER_WRITER_KEY)) {
+        writer->error = JSON_INCITER_INVALID;
+        return writer->error;
+    } else if (writer->state & _JSON_INCITER_WRITER_MEMBER) {
+        _json_inciter_writer_put(writer, ",", 1);
+    }
+
+    writer->state = _JSON_INCITER_WRITER_KEY;
+    _json_inciter_writer_put(writer, key.start, key.length);
+    return writer->error == JSON_INCITER_OK ? _json_inciter_writer_put(writer, ":", 1) : writer->error;
+}
+
+
+#ifdef JSON_INCITER_MMAP
+
+/**
+ * @brief Map a file into memory, read only, so that it can be parsed in place with the `_n` functions (starting with
+ * `json_inciter_parse_document_n`): nothing is copied and pages are read by the kernel as they are first touched.
+ * The kernel is told that the file will be read sequentially, and soon.
+ *
+ * @param path the file
+ * @param file the view to be filled, released with `json_inciter_file_unmap`
+ *
+ * @return JSON_INCITER_OK, JSON_INCITER_INVALID if the file cannot be opened or mapped (`errno` tells why), or
+ * JSON_INCITER_OVERFLOW if it does not fit the address space
+ */
+json_inciter_t json_inciter_file_map(const char *path, json_inciter_file_t *file) {
+    struct stat status;
+    void       *mapping = NULL;
+    int         fd      = open(path, O_RDONLY);
+
+    file->buffer = "";
+    file->length = 0;
+    if (fd < 0) {
+        return JSON_INCITER_INVALID;
+    } else if (fstat(fd, &status) != 0) {
+        close(fd);
+        return JSON_INCITER_INVALID;
+    } else if ((uintmax_t)status.st_size > SIZE_MAX) {
+        close(fd);
+        return JSON_INCITER_OVERFLOW;
+    } else if (status.st_size == 0) {
+        close(fd);
+        return JSON_INCITER_OK;
+    }
+
+    // The mapping holds its own reference to the file
+    mapping = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return JSON_INCITER_INVALID;
+    }
+
+#if defined(MADV_SEQUENTIAL) && defined(MADV_WILLNEED)
+    madvise(mapping, (size_t)status.st_size, MADV_SEQUENTIAL);
+    madvise(mapping, (size_t)status.st_size, MADV_WILLNEED);
+#elif defined(POSIX_MADV_SEQUENTIAL) && defined(POSIX_MADV_WILLNEED)
+    posix_madvise(mapping, (size_t)status.st_size, POSIX_MADV_SEQUENTIAL);
+    posix_madvise(mapping, (size_t)status.st_size, POSIX_MADV_WILLNEED);
+#endif
+
+    file->buffer = (const char *)mapping;
+    file->length = (size_t)status.st_size;
+    return JSON_INCITER_OK;
+}
+
+
+/**
+ * @brief Release a file mapped by `json_inciter_file_map`. Elements pointing into it must not be used afterwards.
+ *
+ * @param file the view, emptied
+ */
+void json_inciter_file_unmap(json_inciter_file_t *file) {
+    if (file->length > 0) {
+        munmap((void *)file->buffer, file->length);
+    }
+    file->buffer = "";
+    file->length = 0;
+}
+
+#endif
+
+
+#ifdef JSON_INCITER_STATS
+/**
+ * @brief Count the work done by the calling thread into caller supplied counters (one set per request, say) instead
+ * of the thread's own. The counters must not be bound to several threads at once.
+ *
+ * @param stats counters to add to, NULL to go back to the thread's own
+ */
+void json_inciter_stats_bind(json_inciter_stats_t *stats) {
+    _json_inciter_stats_bound = stats;
+}
+
+
+/**
+ * @brief Copy the counters of the calling thread (or the ones bound to it). The parallel functions add the counters
+ * of their threads to the calling thread's before returning.
+ *
+ * @param stats pointer to be filled with the counters
+ */
+void json_inciter_stats_snapshot(json_inciter_stats_t *stats) {
+    *stats = *_JSON_INCITER_STATS;
+}
+
+
+/**
+ * @brief Zero the counters of the calling thread (or the ones bound to it)
+ */
+void json_inciter_stats_reset(void) {
+    memset(_JSON_INCITER_STATS, 0, sizeof(json_inciter_stats_t));
+}
+
+
+/**
+ * @brief Name of a counted function, to label exported metrics
+ *
+ * @param api
+ *
+ * @return lower case name, "unknown" when out of range
+ */
+const char *json_inciter_stats_api_name(json_inciter_stats_api_t api) {
+    static const char *const names[JSON_INCITER_STATS_APIS] = {
+        "parse", "find", "path", "iter", "validate", "walk", "tape", "records",
+    };
+    return (size_t)api < JSON_INCITER_STATS_APIS ? names[api] : "unknown";
+}
+#endif
+
+
 #undef IS_TERMINATOR
+#undef IS_DIGIT
 
 
 #endif
@@ -0,0 +1,387 @@
+#ifndef JSON_INCITER_HPP_INCLUDED
+#define JSON_INCITER_HPP_INCLUDED
+
+// JSON_INCITER, C++17 views over the C API. Nothing is allocated: values are elements of the caller's buffer, which
+// must outlive them, and every call inlines down to the C function it wraps.
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "json_inciter.h"
+
+
+namespace json_inciter {
+
+
+/**
+ * @brief Precompiled key (see `JSON_INCITER_KEY`), whose length, prefix and hash are computed at compile time when the
+ * key is declared `constexpr`: `static constexpr json_inciter::key id("id");`
+ */
+class key {
+  public:
+    /**
+     * @brief Precompile a NUL terminated key, string literal or not; it is measured at compile time when the key is
+     * declared `constexpr`
+     *
+     * @param name key, which must outlive the precompiled key
+     */
+    constexpr key(const char *name) : key(std::string_view(name, std::char_traits<char>::length(name))) {}
+
+    /**
+     * @brief Precompile a key of known length; `name` must outlive the precompiled key
+     *
+     * @param name
+     */
+    constexpr explicit key(std::string_view name)
+        : compiled_{name.data(), name.size(), prefix(name.data(), name.size()), hash(name.data(), name.size())} {}
+
+    /**
+     * @brief The precompiled key, as used by the C API
+     */
+    constexpr const json_inciter_key_t &c_key() const { return compiled_; }
+
+  private:
+    // First 8 bytes of the key, zero padded, as `_json_inciter_key_prefix` loads them from memory
+    static constexpr std::uint64_t prefix(const char *key, std::size_t length) {
+        std::uint64_t prefix = 0;
+        for (std::size_t i = 0; i < length && i < sizeof(prefix); i++) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            prefix |= std::uint64_t(static_cast<unsigned char>(key[i])) << (8 * (sizeof(prefix) - 1 - i));
+#else
+            prefix |= std::uint64_t(static_cast<unsigned char>(key[i])) << (8 * i);
+#endif
+        }
+        return prefix;
+    }
+
+    // FNV-1a hash of the key, as `_json_inciter_key_hash` computes it
+    static constexpr std::uint32_t hash(const char *key, std::size_t length) {
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < length; i++) {
+            hash = (hash ^ static_cast<unsigned char>(key[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    json_inciter_key_t compiled_;
+};
+
+
+namespace literals {
+
+/**
+ * @brief Precompiled key from a literal, `"id"_key`
+ */
+constexpr key operator""_key(const char *literal, std::size_t length) { return key(std::string_view(literal, length)); }
+
+}     // namespace literals
+
+
+/**
+ * @brief Value converted by `value::get`, along with the result of the conversion
+ */
+template <class T> struct result {
+    T              value;     // Converted value, T() unless `error` is JSON_INCITER_OK
+    json_inciter_t error;     // Result of the lookups and of the conversion
+
+    /**
+     * @brief Whether the conversion succeeded
+     */
+    constexpr bool ok() const { return error == JSON_INCITER_OK; }
+
+    /**
+     * @brief The converted value, or `fallback` if the conversion failed
+     */
+    constexpr T value_or(T fallback) const { return ok() ? value : fallback; }
+};
+
+
+template <class Member> class range;
+struct member;
+
+
+/**
+ * @brief View of a json element, or of the error that prevented getting it. Errors carry through lookups, so chains
+ * like `root["a"]["b"].get<int>()` are checked once, at the end.
+ */
+class value {
+  public:
+    /**
+     * @brief Missing value, JSON_INCITER_DONE
+     */
+    constexpr value() : element_{}, error_(JSON_INCITER_DONE) {}
+
+    /**
+     * @brief View of a parsed element
+     *
+     * @param element
+     * @param error JSON_INCITER_OK, or why the element could not be parsed
+     */
+    constexpr value(const json_inciter_element_t &element, json_inciter_t error = JSON_INCITER_OK)
+        : element_(element), error_(error) {}
+
+    /**
+     * @brief Parse the first value of a json document, which ends with `json` (see `json_inciter_parse_document_n`)
+     *
+     * @param json
+     * @param flags parsing mode (json_inciter_flag_t), kept by the values found below this one
+     *
+     * @return the value, or the parse error
+     */
+    static value parse(std::string_view json, std::uint8_t flags = 0) {
+        json_inciter_element_t element = {};
+        element.flags                  = flags;
+        json_inciter_t error           = json_inciter_parse_document_n(json.data(), json.size(), &element);
+        return value(element, error);
+    }
+
+    /**
+     * @brief JSON_INCITER_OK, or the error of the lookup or parse that led to this value
+     */
+    constexpr json_inciter_t error() const { return error_; }
+
+    /**
+     * @brief Whether the value was found
+     */
+    constexpr bool ok() const { return error_ == JSON_INCITER_OK; }
+
+    /**
+     * @brief Tag of the element, only meaningful when `ok()`
+     */
+    constexpr json_inciter_element_tag_t tag() const { return element_.tag; }
+
+    /**
+     * @brief The element, as used by the C API
+     */
+    constexpr const json_inciter_element_t &c_element() const { return element_; }
+
+    constexpr bool is_null() const { return ok() && element_.tag == JSON_INCITER_ELEMENT_TAG_NULL; }
+    constexpr bool is_bool() const {
+        return ok() &&
+               (element_.tag == JSON_INCITER_ELEMENT_TAG_TRUE || element_.tag == JSON_INCITER_ELEMENT_TAG_FALSE);
+    }
+    constexpr bool is_number() const { return ok() && element_.tag == JSON_INCITER_ELEMENT_TAG_NUMBER; }
+    constexpr bool is_string() const { return ok() && element_.tag == JSON_INCITER_ELEMENT_TAG_STRING; }
+    constexpr bool is_array() const { return ok() && element_.tag == JSON_INCITER_ELEMENT_TAG_ARRAY; }
+    constexpr bool is_object() const { return ok() && element_.tag == JSON_INCITER_ELEMENT_TAG_OBJECT; }
+
+    /**
+     * @brief The json text of the value; the end of a lazy container is looked for on every call
+     *
+     * @return the text, empty if the value is missing or the end of its container cannot be found
+     */
+    std::string_view raw() const {
+        json_inciter_element_t element = element_;
+        if (!ok() || json_inciter_element_resolve(&element) != JSON_INCITER_OK) {
+            return std::string_view();
+        }
+        return std::string_view(element.start, element.length);
+    }
+
+    /**
+     * @brief Content of a string, within the quotes, its escape sequences left as they are (see `copy_string`)
+     *
+     * @return the content, empty if the value is not a string
+     */
+    constexpr std::string_view string() const {
+        return is_string() ? std::string_view(element_.as.string, JSON_INCITER_STRING_LENGTH(element_))
+                           : std::string_view();
+    }
+
+    /**
+     * @brief Copy the content of a string, its escape sequences decoded (see `json_inciter_copy_string`)
+     *
+     * @param destination
+     * @param size
+     * @param required pointer to be filled with the size needed, NUL terminator included; can be NULL
+     *
+     * @return result
+     */
+    json_inciter_t copy_string(char *destination, std::size_t size, std::size_t *required = nullptr) const {
+        return ok() ? json_inciter_copy_string(destination, size, element_, required) : error_;
+    }
+
+    /**
+     * @brief Value of a key of this object (see `json_inciter_find_key_in_object`)
+     *
+     * @param required_key precompiled key
+     *
+     * @return the value, JSON_INCITER_DONE if the key is missing, JSON_INCITER_INVALID if this is not an object
+     */
+    value operator[](const key &required_key) const {
+        if (!ok()) {
+            return *this;
+        }
+        json_inciter_element_t element = {};
+        json_inciter_t         error   = json_inciter_find_key_in_object(element_, &required_key.c_key(), &element);
+        return value(element, error);
+    }
+
+    /**
+     * @brief Value of a key of this object
+     */
+    value operator[](std::string_view required_key) const {
+        if (!ok()) {
+            return *this;
+        }
+        json_inciter_element_t element = {};
+        json_inciter_t         error   = json_inciter_find_value_in_object_n(element_, required_key.data(),
+                                                                             required_key.size(), &element);
+        return value(element, error);
+    }
+
+    /**
+     * @brief Value of a key of this object, NUL terminated; declare a `constexpr` key for keys used repeatedly
+     */
+    value operator[](const char *required_key) const {
+        return (*this)[std::string_view(required_key, std::char_traits<char>::length(required_key))];
+    }
+
+    /**
+     * @brief Convert a number (or a boolean, for `bool`) to an arithmetic type. Integers are read without going
+     * through floating point and checked against the range of `T`.
+     *
+     * @return the converted value, with JSON_INCITER_OK, JSON_INCITER_OVERFLOW if the number does not fit, or
+     * JSON_INCITER_INVALID if the value is not of a convertible type
+     */
+    template <class T> result<T> get() const {
+        static_assert(std::is_arithmetic<T>::value, "json_inciter::value::get converts to arithmetic types");
+        result<T> converted = {T(), error_};
+
+        if (!ok()) {
+            return converted;
+        } else if constexpr (std::is_same<T, bool>::value) {
+            converted.value = element_.tag == JSON_INCITER_ELEMENT_TAG_TRUE;
+            converted.error = is_bool() ? JSON_INCITER_OK : JSON_INCITER_INVALID;
+        } else if constexpr (std::is_floating_point<T>::value) {
+            double number   = 0;
+            converted.error = json_inciter_element_as_double(element_, &number);
+            converted.value = static_cast<T>(number);
+        } else if constexpr (std::is_signed<T>::value) {
+            std::int64_t number = 0;
+            converted.error     = json_inciter_element_as_int64(element_, &number);
+            if (converted.error == JSON_INCITER_OK &&
+                (number < std::numeric_limits<T>::min() || number > std::numeric_limits<T>::max())) {
+                converted.error = JSON_INCITER_OVERFLOW;
+            }
+            converted.value = converted.error == JSON_INCITER_OK ? static_cast<T>(number) : T();
+        } else {
+            std::uint64_t number = 0;
+            converted.error      = json_inciter_element_as_uint64(element_, &number);
+            if (converted.error == JSON_INCITER_OK && number > std::numeric_limits<T>::max()) {
+                converted.error = JSON_INCITER_OVERFLOW;
+            }
+            converted.value = converted.error == JSON_INCITER_OK ? static_cast<T>(number) : T();
+        }
+        return converted;
+    }
+
+    /**
+     * @brief Members of this array, for range-for loops
+     */
+    range<value> elements() const;
+
+    /**
+     * @brief Key and value pairs of this object, for range-for loops
+     */
+    range<member> members() const;
+
+  private:
+    json_inciter_element_t element_;
+    json_inciter_t         error_;
+};
+
+
+/**
+ * @brief Member of an object, see `value::members`
+ */
+struct member {
+    json_inciter::value key;       // Key, as a string value
+    json_inciter::value value;     // Value
+};
+
+
+/**
+ * @brief End of a range, see `range`
+ */
+struct sentinel {};
+
+
+/**
+ * @brief Iterator over the members of a container, on top of `json_inciter_iter_next`. A missing container has no
+ * members; a member that cannot be parsed, or a container that is not one, is returned once with its error.
+ */
+template <class Member> class iterator {
+  public:
+    explicit iterator(const value &container) : iter_{}, key_{}, value_{}, result_(container.error()) {
+        if (container.ok() && (result_ = json_inciter_iter_init(&iter_, container.c_element())) == JSON_INCITER_OK) {
+            value_.flags = json_inciter_element_flags(container.c_element());
+            next();
+        }
+    }
+
+    Member operator*() const {
+        if constexpr (std::is_same<Member, member>::value) {
+            return member{value(key_, result_), value(value_, result_)};
+        } else {
+            return value(value_, result_);
+        }
+    }
+
+    iterator &operator++() {
+        if (result_ != JSON_INCITER_OK) {
+            result_ = JSON_INCITER_DONE;
+        } else {
+            next();
+        }
+        return *this;
+    }
+
+    bool operator!=(sentinel) const { return result_ != JSON_INCITER_DONE; }
+
+  private:
+    void next() {
+        value_.flags = json_inciter_element_flags(value_);
+        result_ = json_inciter_iter_next(&iter_, std::is_same<Member, member>::value ? &key_ : nullptr, &value_);
+    }
+
+    json_inciter_iter_t    iter_;
+    json_inciter_element_t key_;
+    json_inciter_element_t value_;
+    json_inciter_t         result_;
+};
+
+
+/**
+ * @brief Members of a container, see `value::elements` and `value::members`
+ */
+template <class Member> class range {
+  public:
+    explicit range(const value &container) : container_(container) {}
+
+    iterator<Member> begin() const { return iterator<Member>(container_); }
+    sentinel         end() const { return sentinel(); }
+
+  private:
+    value container_;
+};
+
+
+inline range<value> value::elements() const {
+    return range<value>(is_array() || !ok() ? *this : value(element_, JSON_INCITER_INVALID));
+}
+
+
+inline range<member> value::members() const {
+    return range<member>(is_object() || !ok() ? *this : value(element_, JSON_INCITER_INVALID));
+}
+
+
+}     // namespace json_inciter
+
+#endif     // JSON_INCITER_HPP_INCLUDED
@@ -5,6 +5,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
+#include <locale.h>
 #include <cmocka.h>
 #include "json_inciter.h"
 
@@ -21,6 +22,16 @@
     assert_int_equal(Result.as.number, Number);
 
 
+/* Copy a json string into a heap buffer of the exact size, without NUL terminator */
+static char *unterminated_copy(const char *json, size_t *length) {
+    *length      = strlen(json);
+    char *buffer = malloc(*length > 0 ? *length : 1);
+    assert(buffer != NULL);
+    memcpy(buffer, json, *length);
+    return buffer;
+}
+
+
 /* These functions will be used to initialize
    and clean resources up after each test run */
 int setup(void **state) {
@@ -201,6 +212,163 @@ static void test_json_inciter_number(void **state) {
     json_buffer = "123fourfive";
     result      = json_inciter_parse_value(json_buffer, &element);
     assert_int_equal(result, JSON_INCITER_INVALID);
+
+    // Forms accepted by strtod but not by json
+    const char *not_json[] = {"+1", "01", "1.", ".5", "0x10", "1.e3", "-inf", "1e+", "1,5e"};
+    for (size_t i = 0; i < sizeof(not_json) / sizeof(not_json[0]); i++) {
+        json_buffer = not_json[i];
+        if (json_inciter_parse_value(json_buffer, &element) == JSON_INCITER_OK) {
+            // Only the part before the comma is a number
+            assert_int_equal(json_buffer[element.length], ',');
+        }
+    }
+    assert_int_equal(json_inciter_parse_value("0x10", &element), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_parse_value("1.]", &element), JSON_INCITER_INVALID);
+
+    // Incomplete
+    assert_int_equal(json_inciter_parse_value("-", &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value("12.", &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value("12e-", &element), JSON_INCITER_INCOMPLETE);
+}
+
+
+static void test_json_inciter_number_conversion(void **state) {
+    (void)state;
+    json_inciter_element_t element = {0};
+
+    // Conversions are correctly rounded, whichever path they take
+    const char *numbers[] = {
+        "0",
+        "-0",
+        "0.1",
+        "-73.98745632",
+        "3.141592653589793",
+        "1e22",
+        "1e23",
+        "123e30",
+        "9007199254740993",
+        "18446744073709551615",
+        "2.2250738585072011e-308",
+        "4.9e-324",
+        "1.7976931348623157e308",
+        "1e400",
+        "0.0000000000000000000000000000012345",
+        "123456789012345678901234567890",
+        "0.30000000000000004440892098500626161694526672363281250000000000000000000000000000000000000000000000001",
+        "1234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789"
+        "0123456789012345678901234567890e-100",
+    };
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++) {
+        assert_int_equal(json_inciter_parse_value(numbers[i], &element), JSON_INCITER_OK);
+        assert_int_equal(element.length, strlen(numbers[i]));
+        double expected = strtod(numbers[i], NULL);
+        assert_memory_equal(&element.as.number, &expected, sizeof(double));
+
+        // Cut by the end of the buffer, converted from a copy
+        assert_int_equal(json_inciter_parse_document_n(numbers[i], strlen(numbers[i]), &element), JSON_INCITER_OK);
+        assert_memory_equal(&element.as.number, &expected, sizeof(double));
+    }
+
+    // Long numbers next to a halfway point between two doubles are rounded from all of their digits
+    static char long_number[1024];
+    const struct {
+        const char *digits;     // Followed by zeroes, then `last`
+        char        last;
+        double      expected;
+    } halfway[] = {
+        {"1.00000000000000011102230246251565404236316680908203125", '0', 1.0},
+        {"1.00000000000000011102230246251565404236316680908203125", '1', 1.0 + DBL_EPSILON},
+        {"1.000000000000000111022302462515654042363166809082031249", '9', 1.0},
+        {"1208925819614629308923904.", '0', 0x1p80},
+        {"1208925819614629308923904.", '1', 0x1p80 + 0x1p28},
+        {"-1208925819614629308923904.", '1', -(0x1p80 + 0x1p28)},
+        {"960357075504810077335046174806550583250537861365049085511782682051127461174870937142642419649973130344778989"
+         "997359333072805156837799518089082131630293845981291957159240652051534892784",
+         '\0', 0x1.cee070a42dedep+607},
+    };
+    for (size_t i = 0; i < sizeof(halfway) / sizeof(halfway[0]); i++) {
+        size_t length = strlen(halfway[i].digits);
+        memcpy(long_number, halfway[i].digits, length);
+        if (halfway[i].last != '\0') {
+            memset(&long_number[length], halfway[i].last == '9' ? '9' : '0', 900);
+            length += 900;
+            long_number[length++] = halfway[i].last;
+        }
+        long_number[length] = '\0';
+
+        assert_int_equal(json_inciter_parse_value(long_number, &element), JSON_INCITER_OK);
+        assert_true(element.as.number == halfway[i].expected);
+        assert_int_equal(json_inciter_parse_document_n(long_number, length, &element), JSON_INCITER_OK);
+        assert_true(element.as.number == halfway[i].expected);
+
+        double lazy   = 0;
+        element.flags = JSON_INCITER_FLAG_LAZY_NUMBERS;
+        assert_int_equal(json_inciter_parse_value(long_number, &element), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_element_as_double(element, &lazy), JSON_INCITER_OK);
+        assert_true(lazy == halfway[i].expected);
+        element.flags = 0;
+    }
+
+    srand(4321);
+    for (size_t i = 0; i < 100000; i++) {
+        char     number[64] = {0};
+        uint64_t bits       = ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+        double   value      = 0;
+        memcpy(&value, &bits, sizeof(value));
+        if (value != value || value - value != 0) {
+            continue;     // NaN or infinity
+        }
+        snprintf(number, sizeof(number), "%.*e", rand() % 20, value);
+        assert_int_equal(json_inciter_parse_value(number, &element), JSON_INCITER_OK);
+        double expected = strtod(number, NULL);
+        assert_memory_equal(&element.as.number, &expected, sizeof(double));
+
+        snprintf(number, sizeof(number), "%.*f", rand() % 12, (double)(rand() % 100000) / (1 + rand() % 1000));
+        assert_int_equal(json_inciter_parse_value(number, &element), JSON_INCITER_OK);
+        expected = strtod(number, NULL);
+        assert_memory_equal(&element.as.number, &expected, sizeof(double));
+    }
+
+    // Independent from the decimal separator of the locale, if one that uses a comma is available
+    if (setlocale(LC_NUMERIC, "de_DE.UTF-8") != NULL || setlocale(LC_NUMERIC, "it_IT.UTF-8") != NULL) {
+        assert_int_equal(json_inciter_parse_value("1.5", &element), JSON_INCITER_OK);
+        assert_true(element.as.number == 1.5);
+        assert_int_equal(json_inciter_parse_value("0.30000000000000004440892098500626", &element), JSON_INCITER_OK);
+        assert_true(element.as.number > 0.3 && element.as.number < 0.31);
+        setlocale(LC_NUMERIC, "C");
+    }
+
+    // Exact integers
+    int64_t  int_value  = 0;
+    uint64_t uint_value = 0;
+
+    assert_int_equal(json_inciter_parse_value("9223372036854775807", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_int64(element, &int_value), JSON_INCITER_OK);
+    assert_true(int_value == INT64_MAX);
+    assert_int_equal(json_inciter_parse_value("-9223372036854775808", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_int64(element, &int_value), JSON_INCITER_OK);
+    assert_true(int_value == INT64_MIN);
+    assert_int_equal(json_inciter_element_as_uint64(element, &uint_value), JSON_INCITER_OVERFLOW);
+    assert_int_equal(json_inciter_parse_value("9223372036854775808", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_int64(element, &int_value), JSON_INCITER_OVERFLOW);
+    assert_int_equal(json_inciter_element_as_uint64(element, &uint_value), JSON_INCITER_OK);
+    assert_true(uint_value == 9223372036854775808ULL);
+    assert_int_equal(json_inciter_parse_value("18446744073709551615", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_uint64(element, &uint_value), JSON_INCITER_OK);
+    assert_true(uint_value == UINT64_MAX);
+    assert_int_equal(json_inciter_parse_value("18446744073709551616", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_uint64(element, &uint_value), JSON_INCITER_OVERFLOW);
+    assert_int_equal(json_inciter_parse_value("-0", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_uint64(element, &uint_value), JSON_INCITER_OK);
+    assert_true(uint_value == 0);
+
+    // Not integers
+    assert_int_equal(json_inciter_parse_value("1.5", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_int64(element, &int_value), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_parse_value("1e3", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_uint64(element, &uint_value), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_parse_value("\"12\"", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_int64(element, &int_value), JSON_INCITER_INVALID);
 }
 
 
@@ -258,6 +426,11 @@ static void test_json_inciter_array(void **state) {
     result      = json_inciter_parse_value(json_buffer, &element);
     assert_int_equal(result, JSON_INCITER_OK);
     ASSERT_ELEMENT(element, JSON_INCITER_ELEMENT_TAG_ARRAY, &json_buffer[0], 63);
+
+    // Incomplete
+    json_buffer = "[1,[2, 3]";
+    result      = json_inciter_parse_value(json_buffer, &element);
+    assert_int_equal(result, JSON_INCITER_INCOMPLETE);
 }
 
 
@@ -290,7 +463,7 @@ static void test_json_inciter_object(void **state) {
     assert_int_equal(value.tag, JSON_INCITER_ELEMENT_TAG_STRING);
     char content_buffer[32] = {0};
     json_inciter_copy_content(content_buffer, sizeof(content_buffer), value);
-    assert_true(strcmp(content_buffer, "data"));
+    assert_true(strcmp(content_buffer, "data") == 0);
 }
 
 
@@ -344,13 +517,1892 @@ static void test_json_inciter_api_extraction(void **state) {
 }
 
 
+static void test_json_inciter_bounded(void **state) {
+    (void)state;
+    json_inciter_element_t element     = {0};
+    char                  *json_buffer = NULL;
+    size_t                 length      = 0;
+
+    // Values ending exactly at the end of the buffer
+    json_buffer = unterminated_copy("true", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &element), JSON_INCITER_OK);
+    ASSERT_ELEMENT(element, JSON_INCITER_ELEMENT_TAG_TRUE, &json_buffer[0], 4);
+    free(json_buffer);
+
+    json_buffer = unterminated_copy(" 12.5", &length);
+    assert_int_equal(json_inciter_parse_document_n(json_buffer, length, &element), JSON_INCITER_OK);
+    ASSERT_NUMBER_RESULT(element, JSON_INCITER_ELEMENT_TAG_NUMBER, &json_buffer[1], 4, 12.5);
+    free(json_buffer);
+
+    json_buffer = unterminated_copy("[1, {\"a\": \"]\"}]", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &element), JSON_INCITER_OK);
+    ASSERT_ELEMENT(element, JSON_INCITER_ELEMENT_TAG_ARRAY, &json_buffer[0], length);
+    free(json_buffer);
+
+    // The length is respected even when more json follows: a number cut by it is incomplete, unless the buffer is
+    // known to hold the whole document
+    json_buffer = "12345";
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, 2, &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, 5, &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value_n("-1.5e", 5, &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_document_n(json_buffer, 2, &element), JSON_INCITER_OK);
+    ASSERT_NUMBER_RESULT(element, JSON_INCITER_ELEMENT_TAG_NUMBER, &json_buffer[0], 2, 12);
+    json_buffer = "12 ";
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, 3, &element), JSON_INCITER_OK);
+    ASSERT_NUMBER_RESULT(element, JSON_INCITER_ELEMENT_TAG_NUMBER, &json_buffer[0], 2, 12);
+    assert_int_equal(json_inciter_parse_value_n("12\0", 3, &element), JSON_INCITER_OK);
+
+    // Incomplete values
+    json_buffer = unterminated_copy("fals", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &element), JSON_INCITER_INCOMPLETE);
+    free(json_buffer);
+
+    json_buffer = unterminated_copy("\"escaped\\", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &element), JSON_INCITER_INCOMPLETE);
+    free(json_buffer);
+
+    json_buffer = unterminated_copy("{\"key\": [1, 2]", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &element), JSON_INCITER_INCOMPLETE);
+    free(json_buffer);
+
+    json_buffer = unterminated_copy("   ", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &element), JSON_INCITER_INCOMPLETE);
+    free(json_buffer);
+
+    // Keywords compared as words when enough bytes are available
+    json_buffer = unterminated_copy("false,", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &element), JSON_INCITER_OK);
+    ASSERT_ELEMENT(element, JSON_INCITER_ELEMENT_TAG_FALSE, &json_buffer[0], 5);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, 4, &element), JSON_INCITER_INCOMPLETE);
+    free(json_buffer);
+
+    json_buffer = unterminated_copy("nulL", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &element), JSON_INCITER_INVALID);
+    free(json_buffer);
+
+    assert_int_equal(json_inciter_parse_value_n("tru\0", 4, &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value_n("trueE", 5, &element), JSON_INCITER_INVALID);
+
+    // Keywords after whitespace at the end of a NUL terminated buffer
+    char *keyword = malloc(3);
+    assert(keyword != NULL);
+    memcpy(keyword, " t", 3);
+    assert_int_equal(json_inciter_parse_value(keyword, &element), JSON_INCITER_INCOMPLETE);
+    free(keyword);
+
+    // Pairs and iteration
+    const char *key     = NULL;
+    size_t      key_len = 0;
+    json_buffer         = unterminated_copy("\"key\" : null ,", &length);
+    assert_int_equal(json_inciter_parse_pair_n(json_buffer, length, &key, &key_len, &element), JSON_INCITER_OK);
+    assert_int_equal(key_len, 3);
+    assert_true(strncmp(key, "key", key_len) == 0);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_NULL);
+
+    const char *next = NULL;
+    const char *end  = json_buffer + length;
+    assert_int_equal(json_inciter_next_element_start_n(JSON_INCITER_ELEMENT_NEXT_START(element),
+                                                       end - JSON_INCITER_ELEMENT_NEXT_START(element),
+                                                       JSON_INCITER_ELEMENT_TAG_OBJECT, &next),
+                     JSON_INCITER_OK);
+    assert_true(next == end);
+    assert_int_equal(json_inciter_next_element_start_n(next, end - next, JSON_INCITER_ELEMENT_TAG_OBJECT, &next),
+                     JSON_INCITER_INCOMPLETE);
+    free(json_buffer);
+
+    json_buffer = unterminated_copy("\"key\"", &length);
+    assert_int_equal(json_inciter_parse_pair_n(json_buffer, length, &key, &key_len, &element),
+                     JSON_INCITER_INCOMPLETE);
+    free(json_buffer);
+
+    json_inciter_continuation_t continuation = {0};
+    json_buffer                              = "\"key\": 12, 3";
+    assert_int_equal(json_inciter_parse_pair_n(json_buffer, 9, &key, &key_len, &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value_resume_n(&json_buffer[7], 2, &continuation, &element),
+                     JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value_resume_n(&json_buffer[7], 3, &continuation, &element), JSON_INCITER_OK);
+    ASSERT_NUMBER_RESULT(element, JSON_INCITER_ELEMENT_TAG_NUMBER, &json_buffer[7], 2, 12);
+
+    // Key lookup with a key that is not NUL terminated
+    json_inciter_element_t object = {0};
+    json_buffer                   = unterminated_copy("{\"first\": 1, \"second\": 2}", &length);
+    assert_int_equal(json_inciter_parse_value_n(json_buffer, length, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_find_value_in_object_n(object, "secondary", 6, &element), JSON_INCITER_OK);
+    ASSERT_NUMBER_RESULT(element, JSON_INCITER_ELEMENT_TAG_NUMBER, &json_buffer[length - 2], 1, 2);
+    assert_int_equal(json_inciter_find_value_in_object_n(object, "third", 5, &element), JSON_INCITER_DONE);
+    free(json_buffer);
+}
+
+static void test_json_inciter_resume(void **state) {
+    (void)state;
+    const char *json_buffer =
+        "  {\"one\": [1, 2, {\"three\": \"}]\\\"\\\\\"}], \"four\": {\"five\": [[]]}, \"six\": \"\\u0041\"}  ";
+    size_t json_len = strlen(json_buffer);
+
+    json_inciter_element_t expected = {0};
+    assert_int_equal(json_inciter_parse_value(json_buffer, &expected), JSON_INCITER_OK);
+
+    // Feed the document one byte at a time, every call only scans the new byte
+    json_inciter_continuation_t continuation = {0};
+    json_inciter_element_t      element      = {0};
+    size_t                      received     = 0;
+    json_inciter_t              result       = JSON_INCITER_INCOMPLETE;
+
+    for (received = 0; received <= json_len && result == JSON_INCITER_INCOMPLETE; received++) {
+        result = json_inciter_parse_value_resume_n(json_buffer, received, &continuation, &element);
+        if (result == JSON_INCITER_INCOMPLETE && received > 2) {
+            assert_int_equal(continuation.offset, received);
+        }
+    }
+    assert_int_equal(result, JSON_INCITER_OK);
+    ASSERT_ELEMENT(element, JSON_INCITER_ELEMENT_TAG_OBJECT, expected.start, expected.length);
+    assert_int_equal(continuation.offset, 0);
+
+    // Strings are resumed as well, also when interrupted right after a backslash
+    json_buffer = "\"abc\\\"def\"";
+    json_len    = strlen(json_buffer);
+    for (received = 0; received < json_len; received++) {
+        assert_int_equal(json_inciter_parse_value_resume_n(json_buffer, received, &continuation, &element),
+                         JSON_INCITER_INCOMPLETE);
+    }
+    assert_int_equal(json_inciter_parse_value_resume_n(json_buffer, json_len, &continuation, &element),
+                     JSON_INCITER_OK);
+    ASSERT_ELEMENT(element, JSON_INCITER_ELEMENT_TAG_STRING, &json_buffer[0], json_len);
+
+    // Invalid json is still reported
+    json_buffer = "[1, 2}";
+    assert_int_equal(json_inciter_parse_value_resume_n(json_buffer, 3, &continuation, &element),
+                     JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value_resume(json_buffer, &continuation, &element), JSON_INCITER_INVALID);
+}
+
+/* Byte-at-a-time reference for the string scanner */
+static size_t reference_skip_string(const char *buffer, size_t length) {
+    size_t to_skip = 0;
+    while (to_skip < length && buffer[to_skip] != '\0' && buffer[to_skip] != '"') {
+        to_skip += buffer[to_skip] == '\\' ? 2 : 1;
+    }
+    return to_skip < length ? to_skip : length;
+}
+
+
+static void test_json_inciter_vectorized_scan(void **state) {
+    (void)state;
+    static const char specials[] = "[]{}\"\"\\\\ ,:";
+    static char       storage[1024 + 128];
+
+    srand(1234);
+    for (size_t iteration = 0; iteration < 20000; iteration++) {
+        char  *buffer = &storage[64 - ((uintptr_t)storage % 64) + (size_t)(rand() % 64)];
+        size_t length = (size_t)(rand() % 1024);
+        int    sparse = 1 << (rand() % 8);
+
+        // Either random bytes or strings with escapes, where backslashes never appear outside of a string
+        if (rand() % 2) {
+            for (size_t i = 0; i < length; i++) {
+                buffer[i] = (rand() % sparse) == 0 ? specials[rand() % (sizeof(specials) - 1)] : 'a';
+            }
+        } else {
+            for (size_t i = 0; i < length;) {
+                if (rand() % 4 == 0) {
+                    buffer[i++] = '"';
+                    for (size_t chars = (size_t)(rand() % 80); chars > 0 && i < length; chars--) {
+                        if (rand() % sparse == 0) {
+                            buffer[i++] = '\\';
+                            if (i < length) {
+                                buffer[i++] = "\"\\[}a"[rand() % 5];
+                            }
+                        } else {
+                            buffer[i++] = (rand() % sparse == 0) ? "[]{}"[rand() % 4] : 'a';
+                        }
+                    }
+                    if (i < length) {
+                        buffer[i++] = '"';
+                    }
+                } else {
+                    buffer[i++] = "[]{} ,:a"[rand() % 8];
+                }
+            }
+        }
+        buffer[length] = '\0';
+        // Either bounded or NUL terminated
+        size_t scan_length = (rand() % 2) ? length : SIZE_MAX;
+
+        json_inciter_continuation_t vectorized = {0};
+        vectorized.offset                      = (size_t)(rand() % 8) % (length + 1);
+        vectorized.array_depth                 = (size_t)(rand() % 3);
+        vectorized.object_depth                = (size_t)(rand() % 3);
+        switch (rand() % 4) {
+            case 0:
+                vectorized.state = 0x02 | 0x04;     // After a backslash in a string
+                break;
+            case 1:
+                vectorized.state = 0x02;     // In a string
+                break;
+            default:
+                break;
+        }
+        json_inciter_continuation_t scalar = vectorized;
+
+        char           terminator    = (rand() % 2) ? ']' : '}';
+        json_inciter_t vector_result = _json_inciter_skip_to_terminator(buffer, scan_length, terminator, &vectorized);
+        json_inciter_t scalar_result =
+            _json_inciter_skip_to_terminator_scalar(buffer, scan_length, terminator, &scalar);
+        assert_int_equal(vector_result, scalar_result);
+        if (vector_result != JSON_INCITER_INVALID) {
+            assert_int_equal(vectorized.offset, scalar.offset);
+            assert_int_equal(vectorized.array_depth, scalar.array_depth);
+            assert_int_equal(vectorized.object_depth, scalar.object_depth);
+            assert_int_equal(vectorized.state, scalar.state);
+        }
+
+        uint8_t string_state = 0;
+        assert_int_equal(_json_inciter_skip_string(buffer, scan_length, &string_state),
+                         reference_skip_string(buffer, length));
+    }
+}
+
+static void test_json_inciter_lazy_numbers(void **state) {
+    (void)state;
+    json_inciter_element_t element = {0};
+    double                 value   = 0;
+
+    // Only the span is recorded
+    element.flags = JSON_INCITER_FLAG_LAZY_NUMBERS;
+    assert_int_equal(json_inciter_parse_value("  -12.5e1 ,", &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_NUMBER);
+    assert_int_equal(element.length, 7);
+    assert_int_equal(element.flags, JSON_INCITER_FLAG_LAZY_NUMBERS);
+    assert_int_equal(json_inciter_element_as_double(element, &value), JSON_INCITER_OK);
+    assert_true(value == -125);
+
+    // The grammar is still checked
+    assert_int_equal(json_inciter_parse_value("12.x", &element), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_parse_value("true", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_double(element, &value), JSON_INCITER_INVALID);
+
+    // Key search only converts the matching value, in the mode of the object; the destination is only written
+    const char            *json_buffer = "{\"a\": 1.25, \"b\": [2], \"c\": 3.5, \"d\": 4}";
+    json_inciter_element_t object      = {0};
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+
+    json_inciter_element_t eager;
+    memset(&eager, 0xFF, sizeof(eager));
+    assert_int_equal(json_inciter_find_value_in_object(object, "c", &eager), JSON_INCITER_OK);
+    ASSERT_NUMBER_RESULT(eager, JSON_INCITER_ELEMENT_TAG_NUMBER, &json_buffer[27], 3, 3.5);
+    assert_int_equal(eager.flags, 0);
+    assert_int_equal(json_inciter_element_as_double(eager, &value), JSON_INCITER_OK);
+    assert_true(value == 3.5);
+
+    object.flags = JSON_INCITER_FLAG_LAZY_NUMBERS;
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_find_value_in_object(object, "d", &element), JSON_INCITER_OK);
+    assert_int_equal(element.flags, JSON_INCITER_FLAG_LAZY_NUMBERS);
+    assert_int_equal(json_inciter_element_as_double(element, &value), JSON_INCITER_OK);
+    assert_true(value == 4);
+}
+
+static void test_json_inciter_find_values(void **state) {
+    (void)state;
+    const char *json_buffer =
+        "{\"id\": 42, \"name\": \"sensor\", \"values\": [1, 2], \"id\": 43, \"enabled\": true, \"last\": null}";
+    json_inciter_element_t object = {0};
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+
+    // Every key found, the walk stops before the last member
+    const char *const      keys[]      = {"enabled", "id", "values"};
+    json_inciter_element_t elements[3] = {0};
+    uint32_t               found_mask  = 0;
+    assert_int_equal(json_inciter_find_values_in_object(object, keys, 3, elements, &found_mask), JSON_INCITER_OK);
+    assert_int_equal(found_mask, 0x7);
+    assert_int_equal(elements[0].tag, JSON_INCITER_ELEMENT_TAG_TRUE);
+    assert_int_equal(elements[1].tag, JSON_INCITER_ELEMENT_TAG_NUMBER);
+    assert_true(elements[1].as.number == 42);     // First occurrence
+    assert_int_equal(elements[2].tag, JSON_INCITER_ELEMENT_TAG_ARRAY);
+    assert_int_equal(elements[2].length, 6);
+
+    // Missing keys are reported in the mask
+    const char *const      partial_keys[]      = {"missing", "last", "name"};
+    json_inciter_element_t partial_elements[3] = {0};
+    object.flags                               = JSON_INCITER_FLAG_LAZY_NUMBERS;
+    assert_int_equal(json_inciter_find_values_in_object(object, partial_keys, 3, partial_elements, &found_mask),
+                     JSON_INCITER_DONE);
+    assert_int_equal(found_mask, 0x6);
+    assert_int_equal(partial_elements[1].tag, JSON_INCITER_ELEMENT_TAG_NULL);
+    assert_int_equal(partial_elements[1].flags, JSON_INCITER_FLAG_LAZY_NUMBERS);
+    assert_int_equal(partial_elements[2].tag, JSON_INCITER_ELEMENT_TAG_STRING);
+
+    // Invalid content
+    json_buffer = "{\"one\": 1, \"two\" 2}";
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_find_values_in_object(object, partial_keys, 3, partial_elements, NULL),
+                     JSON_INCITER_INVALID);
+    json_buffer = "{\"one\": 1 \"two\": 2}";
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_find_value_in_object(object, "two", partial_elements), JSON_INCITER_INVALID);
+}
+
+
+static void test_json_inciter_find_path(void **state) {
+    (void)state;
+    const char *json_buffer = " {\"skip\": {\"a\": [1, {\"b\": 2}]},"
+                              " \"a\": {\"b\": [10, 20, {\"c\": \"found\"}], \"\": 1, \"x/y\": true, \"m~n\": null}}";
+    json_inciter_element_t element = {0};
+
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/b/2/c", &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_STRING);
+    assert_true(strncmp(element.as.string, "found", strlen("found")) == 0);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/b/1", &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 20);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/x~1y", &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_TRUE);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/m~0n", &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_NULL);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/", &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 1);
+    assert_int_equal(json_inciter_find_path(json_buffer, "", &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_OBJECT);
+
+    // Missing members
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/b/3", &element), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/b/01", &element), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/b/-", &element), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/c", &element), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/b/0/c", &element), JSON_INCITER_DONE);
+
+    // Invalid pointers
+    assert_int_equal(json_inciter_find_path(json_buffer, "a", &element), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_find_path(json_buffer, "/a/m~2n", &element), JSON_INCITER_INVALID);
+
+    // Bounded buffers
+    size_t length = 0;
+    char  *copy   = unterminated_copy("{\"a\": [1, 2, 3]}", &length);
+    assert_int_equal(json_inciter_find_path_n(copy, length, "/a/2", &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 3);
+    assert_int_equal(json_inciter_find_path_n(copy, 9, "/a/2", &element), JSON_INCITER_INCOMPLETE);
+    free(copy);
+}
+
+
+static void test_json_inciter_lazy_containers(void **state) {
+    (void)state;
+    const char            *json_buffer = "[{\"a\": [1, 2], \"b\": {\"c\": \"]}\"}}, 3]";
+    json_inciter_element_t element     = {0};
+    json_inciter_element_t value       = {0};
+
+    // Only the start of the container is known
+    element.flags = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_parse_value(json_buffer, &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_ARRAY);
+    assert_true(element.start == json_buffer);
+    assert_int_equal(element.flags & JSON_INCITER_FLAG_LAZY_CONTAINERS, JSON_INCITER_FLAG_LAZY_CONTAINERS);
+
+    // Iterating the contents does not need the end
+    value.flags = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_parse_value(json_inciter_element_content_start(element), &value), JSON_INCITER_OK);
+    assert_int_equal(value.tag, JSON_INCITER_ELEMENT_TAG_OBJECT);
+    json_inciter_element_t inner = {0};
+    assert_int_equal(json_inciter_find_value_in_object(value, "b", &inner), JSON_INCITER_OK);
+    assert_int_equal(inner.tag, JSON_INCITER_ELEMENT_TAG_OBJECT);
+    assert_int_equal(json_inciter_element_flags(inner), JSON_INCITER_FLAG_LAZY_CONTAINERS);
+    assert_int_equal(json_inciter_element_resolve(&inner), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_flags(inner), JSON_INCITER_FLAG_LAZY_CONTAINERS);
+    assert_int_equal(inner.length, 11);     // Lazy as the object it was found in
+
+    // The end is found on demand and cached
+    const char *next = json_inciter_element_next_start(&value);
+    assert_true(next == &json_buffer[32]);
+    assert_int_equal(value.length, 31);
+    assert_int_equal(json_inciter_element_resolve(&value), JSON_INCITER_OK);
+    assert_int_equal(value.length, 31);
+    assert_true(json_inciter_element_next_start(&element) == &json_buffer[strlen(json_buffer)]);
+
+    // The macro only adds the length, which also works on constant elements once resolved
+    const json_inciter_element_t resolved = value;
+    assert_true(JSON_INCITER_ELEMENT_NEXT_START(resolved) == &json_buffer[32]);
+
+    char content_buffer[64];
+    value.flags = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_parse_value(&json_buffer[6], &value), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_copy_content(content_buffer, sizeof(content_buffer), value), 0);
+    assert_string_equal(content_buffer, "[1, 2]");
+
+    // A lazy destination keeps the container open
+    inner.flags = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_find_path(json_buffer, "/0/a", &inner), JSON_INCITER_OK);
+    assert_int_equal(inner.tag, JSON_INCITER_ELEMENT_TAG_ARRAY);
+    assert_true(json_inciter_element_next_start(&inner) == &json_buffer[13]);
+
+    // Errors show up when the end is needed
+    size_t length    = 0;
+    char  *truncated = unterminated_copy("{\"a\": [1, 2]", &length);
+    element.flags    = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_parse_value_n(truncated, length, &element), JSON_INCITER_OK);
+    assert_null(json_inciter_element_next_start(&element));
+    assert_int_equal(json_inciter_element_resolve(&element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_copy_content(content_buffer, sizeof(content_buffer), element), (uint8_t)-1);
+    free(truncated);
+}
+
+
+static void test_json_inciter_tape(void **state) {
+    (void)state;
+    const char *json_buffer = "{\"id\": 7, \"tags\": [\"a\", [], {}], \"owner\": {\"name\": \"x\", \"age\": 1.5},"
+                              " \"a/b\": null}";
+    uint32_t               tape[JSON_INCITER_TAPE_WORDS(16)];
+    size_t                 entries = 0;
+    size_t                 entry   = 0;
+    json_inciter_element_t element = {0};
+
+    // Object, 4 keys, 4 values, 3 array items, 2 nested keys and values
+    assert_int_equal(json_inciter_tape_build(json_buffer, tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_OK);
+    assert_int_equal(entries, 16);
+    assert_int_equal(json_inciter_tape_next(tape, 0), 16);
+    assert_int_equal(json_inciter_tape_element(json_buffer, tape, 0, &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_OBJECT);
+    assert_int_equal(element.length, strlen(json_buffer));
+
+    // Same elements as the text based lookups
+    const char *paths[] = {"", "/id", "/tags", "/tags/0", "/tags/1", "/tags/2", "/owner", "/owner/age", "/a~1b"};
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        json_inciter_element_t expected = {0};
+        assert_int_equal(json_inciter_find_path(json_buffer, paths[i], &expected), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_tape_find_path(json_buffer, tape, paths[i], &entry), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_tape_element(json_buffer, tape, entry, &element), JSON_INCITER_OK);
+        assert_int_equal(element.tag, expected.tag);
+        assert_true(element.start == expected.start);
+        assert_int_equal(element.length, expected.length);
+        assert_true(element.tag != JSON_INCITER_ELEMENT_TAG_NUMBER || element.as.number == expected.as.number);
+    }
+    assert_int_equal(json_inciter_tape_find_path(json_buffer, tape, "/tags/3", &entry), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_tape_find_path(json_buffer, tape, "/tags/1/0", &entry), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_tape_find_path(json_buffer, tape, "/id/0", &entry), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_tape_find_path(json_buffer, tape, "id", &entry), JSON_INCITER_INVALID);
+
+    // Iterating an array, skipping its subtrees
+    size_t tags    = 0;
+    size_t n_items = 0;
+    assert_int_equal(json_inciter_tape_find_value_in_object(json_buffer, tape, 0, "tags", &tags), JSON_INCITER_OK);
+    for (entry = tags + 1; entry < json_inciter_tape_next(tape, tags); entry = json_inciter_tape_next(tape, entry)) {
+        n_items++;
+    }
+    assert_int_equal(n_items, 3);
+    assert_int_equal(json_inciter_tape_find_value_in_object(json_buffer, tape, 0, "name", &entry), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_tape_find_value_in_object(json_buffer, tape, tags, "a", &entry),
+                     JSON_INCITER_INVALID);
+
+    // Lazy numbers are left to `json_inciter_element_as_double`
+    double number = 0;
+    element.flags = JSON_INCITER_FLAG_LAZY_NUMBERS;
+    assert_int_equal(json_inciter_tape_find_path(json_buffer, tape, "/owner/age", &entry), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_tape_element(json_buffer, tape, entry, &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_as_double(element, &number), JSON_INCITER_OK);
+    assert_true(number == 1.5);
+
+    // The tape is never written past its capacity
+    tape[JSON_INCITER_TAPE_WORDS(15)] = 0xdeadbeef;
+    assert_int_equal(json_inciter_tape_build(json_buffer, tape, JSON_INCITER_TAPE_WORDS(15), &entries),
+                     JSON_INCITER_OVERFLOW);
+    assert_int_equal(entries, 15);
+    assert_int_equal(tape[JSON_INCITER_TAPE_WORDS(15)], 0xdeadbeef);
+
+    // Scalars, errors
+    assert_int_equal(json_inciter_tape_build(" 12 ", tape, JSON_INCITER_TAPE_WORDS(1), &entries), JSON_INCITER_OK);
+    assert_int_equal(entries, 1);
+    assert_int_equal(json_inciter_tape_build("[1, 2", tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_tape_build("[1, 2,]", tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_tape_build("{\"a\" 1}", tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_tape_build("[1}", tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_INVALID);
+
+    size_t length = 0;
+    char  *copy   = unterminated_copy("[[1], {\"a\": []}]", &length);
+    assert_int_equal(json_inciter_tape_build_n(copy, length, tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_OK);
+    assert_int_equal(entries, 6);
+    assert_int_equal(json_inciter_tape_build_n(copy, length - 1, tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_INCOMPLETE);
+    free(copy);
+
+    // Only the top level value ends with the buffer
+    assert_int_equal(json_inciter_tape_build_n("[1, 23]", 5, tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_tape_build_n("230", 2, tape, JSON_INCITER_TAPE_WORDS(16), &entries),
+                     JSON_INCITER_OK);
+    assert_int_equal(json_inciter_tape_element("230", tape, 0, &element), JSON_INCITER_OK);
+    assert_int_equal(element.length, 2);
+}
+
+
+static void test_json_inciter_key_index(void **state) {
+    (void)state;
+    const char *json_buffer = "{\"ab\": 1, \"a\\u0062\": 2, \"caf\\u00e9\": 3, \"\\ud83d\\ude00\": [4], \"a\\\\b\": 5,"
+                              " \"\\n\": {\"x\": 6}}";
+    json_inciter_element_t  object   = {0};
+    json_inciter_element_t  element  = {0};
+    json_inciter_key_slot_t slots[6] = {0};
+
+    // A full table forces probing
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_key_index_build(object, slots, 6), JSON_INCITER_OK);
+
+    // Escaped keys match their unescaped form, the first occurrence is kept
+    assert_int_equal(json_inciter_key_index_find(object, slots, 6, "ab", &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 1);
+    assert_int_equal(json_inciter_key_index_find(object, slots, 6, "caf\xc3\xa9", &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 3);
+    assert_int_equal(json_inciter_key_index_find(object, slots, 6, "\xf0\x9f\x98\x80", &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_ARRAY);
+    assert_int_equal(element.length, 3);
+    assert_int_equal(json_inciter_key_index_find(object, slots, 6, "a\\b", &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 5);
+    assert_int_equal(json_inciter_key_index_find_n(object, slots, 6, "\nx", 1, &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_OBJECT);
+    assert_int_equal(json_inciter_key_index_find(object, slots, 6, "a\\u0062", &element), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_key_index_find(object, slots, 6, "caf", &element), JSON_INCITER_DONE);
+
+    // Too small a table
+    assert_int_equal(json_inciter_key_index_build(object, slots, 4), JSON_INCITER_OVERFLOW);
+
+    // Same results as the linear walk on a large object
+    char                    large[16384];
+    json_inciter_key_slot_t large_slots[1024];
+    size_t                  length = 0;
+    length += (size_t)sprintf(&large[length], "{");
+    for (int i = 0; i < 500; i++) {
+        length += (size_t)sprintf(&large[length], "%s\"key%d\": %d", i > 0 ? ", " : "", i, i);
+    }
+    sprintf(&large[length], "}");
+    assert_int_equal(json_inciter_parse_value(large, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_key_index_build(object, large_slots, 1024), JSON_INCITER_OK);
+    for (int i = 0; i < 510; i++) {
+        char                   key[16];
+        json_inciter_element_t expected = {0};
+        sprintf(key, "key%d", i);
+        assert_int_equal(json_inciter_key_index_find(object, large_slots, 1024, key, &element),
+                         json_inciter_find_value_in_object(object, key, &expected));
+        assert_true(i >= 500 || (element.start == expected.start && element.as.number == i));
+    }
+
+    // Empty and invalid objects
+    assert_int_equal(json_inciter_parse_value("{ }", &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_key_index_build(object, slots, 6), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_key_index_find(object, slots, 6, "ab", &element), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_parse_value("{\"\\x\": 1}", &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_key_index_build(object, slots, 6), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_parse_value("{\"a\": 1 \"b\": 2}", &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_key_index_build(object, slots, 6), JSON_INCITER_INVALID);
+}
+
+
+static void test_json_inciter_precompiled_keys(void **state) {
+    (void)state;
+    const char *json_buffer =
+        "{\"identifier_a\": 1, \"identifier_b\": 2, \"id\": 3, \"\": 4, \"ident\": 5, \"identifi\": 6}";
+    json_inciter_element_t object  = {0};
+    json_inciter_element_t element = {0};
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+
+    // Keys sharing their length and prefix, shorter than the prefix, empty
+    json_inciter_key_t key = JSON_INCITER_KEY("identifier_b");
+    assert_int_equal(key.length, 12);
+    assert_int_equal(key.hash, json_inciter_key_make("identifier_b").hash);
+    assert_int_equal(json_inciter_find_key_in_object(object, &key, &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 2);
+    key = JSON_INCITER_KEY("id");
+    assert_int_equal(json_inciter_find_key_in_object(object, &key, &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 3);
+    key = JSON_INCITER_KEY("");
+    assert_int_equal(json_inciter_find_key_in_object(object, &key, &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 4);
+    key = JSON_INCITER_KEY("identifi");
+    assert_int_equal(json_inciter_find_key_in_object(object, &key, &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 6);
+    key = JSON_INCITER_KEY("identifier_c");
+    assert_int_equal(json_inciter_find_key_in_object(object, &key, &element), JSON_INCITER_DONE);
+    key = json_inciter_key_make_n("identifier", 5);
+    assert_int_equal(json_inciter_find_key_in_object(object, &key, &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 5);
+
+    // Several keys at once
+    const json_inciter_key_t keys[]      = {JSON_INCITER_KEY("ident"), JSON_INCITER_KEY("identifier_a"),
+                                            JSON_INCITER_KEY("missing")};
+    json_inciter_element_t   elements[3] = {0};
+    uint32_t                 found_mask  = 0;
+    assert_int_equal(json_inciter_find_keys_in_object(object, keys, 3, elements, &found_mask), JSON_INCITER_DONE);
+    assert_int_equal(found_mask, 0x3);
+    assert_true(elements[0].as.number == 5);
+    assert_true(elements[1].as.number == 1);
+
+    // Through a key index
+    json_inciter_key_slot_t slots[12];
+    assert_int_equal(json_inciter_key_index_build(object, slots, 12), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_key_index_find_key(object, slots, 12, &keys[1], &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 1);
+    assert_int_equal(json_inciter_key_index_find_key(object, slots, 12, &keys[2], &element), JSON_INCITER_DONE);
+}
+
+
+typedef struct {
+    double  latitude;
+    float   longitude;
+} test_position_t;
+
+typedef struct {
+    int32_t                id;
+    uint8_t                level;
+    uint8_t                enabled;
+    char                   name[8];
+    test_position_t        position;
+    json_inciter_element_t tags;
+    int64_t                missing;
+} test_device_t;
+
+static void test_json_inciter_bind_object(void **state) {
+    (void)state;
+    static const json_inciter_field_t position_fields[] = {
+        JSON_INCITER_FIELD("lat", JSON_INCITER_FIELD_TYPE_DOUBLE, test_position_t, latitude),
+        JSON_INCITER_FIELD("lon", JSON_INCITER_FIELD_TYPE_DOUBLE, test_position_t, longitude),
+    };
+    static const json_inciter_field_t device_fields[] = {
+        JSON_INCITER_FIELD("id", JSON_INCITER_FIELD_TYPE_INT, test_device_t, id),
+        JSON_INCITER_FIELD("level", JSON_INCITER_FIELD_TYPE_UINT, test_device_t, level),
+        JSON_INCITER_FIELD("enabled", JSON_INCITER_FIELD_TYPE_BOOL, test_device_t, enabled),
+        JSON_INCITER_FIELD("name", JSON_INCITER_FIELD_TYPE_STRING, test_device_t, name),
+        JSON_INCITER_FIELD_OBJECT("position", test_device_t, position, position_fields),
+        JSON_INCITER_FIELD("tags", JSON_INCITER_FIELD_TYPE_ELEMENT, test_device_t, tags),
+        JSON_INCITER_FIELD("missing", JSON_INCITER_FIELD_TYPE_INT, test_device_t, missing),
+    };
+    json_inciter_element_t object       = {0};
+    test_device_t          device       = {0};
+    uint32_t               present_mask = 0;
+
+    const char *json_buffer = "{\"id\": -42, \"other\": [1, {\"id\": 1}], \"level\": 200, \"enabled\": true,"
+                              " \"name\": \"sensor\", \"position\": {\"lon\": 2.5, \"lat\": 48.5}, \"tags\": [\"a\"],"
+                              " \"missing\": null}";
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_bind_object(object, device_fields, 7, &device, &present_mask), JSON_INCITER_DONE);
+    assert_int_equal(present_mask, 0x3f);
+    assert_int_equal(device.id, -42);
+    assert_int_equal(device.level, 200);
+    assert_int_equal(device.enabled, 1);
+    assert_string_equal(device.name, "sensor");
+    assert_true(device.position.latitude == 48.5);
+    assert_true(device.position.longitude == 2.5f);
+    assert_int_equal(device.tags.tag, JSON_INCITER_ELEMENT_TAG_ARRAY);
+    assert_int_equal(device.tags.length, 5);
+    assert_int_equal(device.missing, 0);
+
+    // Every member set
+    json_buffer = "{\"missing\": 7, \"position\": {\"lat\": 1, \"lon\": 2}, \"tags\": {}, \"name\": \"\","
+                  " \"enabled\": false, \"level\": 0, \"id\": 1}";
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_bind_object(object, device_fields, 7, &device, &present_mask), JSON_INCITER_OK);
+    assert_int_equal(present_mask, 0x7f);
+    assert_int_equal(device.missing, 7);
+    assert_int_equal(device.enabled, 0);
+    assert_string_equal(device.name, "");
+
+    // Type mismatches and overflows
+    const char *mismatches[] = {"{\"id\": \"1\"}", "{\"id\": 1.5}", "{\"enabled\": 1}", "{\"position\": []}",
+                                "{\"position\": {\"lat\": true}}"};
+    for (size_t i = 0; i < sizeof(mismatches) / sizeof(mismatches[0]); i++) {
+        assert_int_equal(json_inciter_parse_value(mismatches[i], &object), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_bind_object(object, device_fields, 7, &device, NULL), JSON_INCITER_INVALID);
+    }
+    const char *overflows[] = {"{\"id\": 2147483648}", "{\"level\": 256}", "{\"level\": -1}",
+                               "{\"name\": \"too long\"}"};
+    for (size_t i = 0; i < sizeof(overflows) / sizeof(overflows[0]); i++) {
+        assert_int_equal(json_inciter_parse_value(overflows[i], &object), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_bind_object(object, device_fields, 7, &device, NULL), JSON_INCITER_OVERFLOW);
+    }
+    assert_int_equal(json_inciter_parse_value("{\"id\": 1 \"level\": 2}", &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_bind_object(object, device_fields, 7, &device, NULL), JSON_INCITER_INVALID);
+
+    // Numbers are only converted to double for the members that need it, elements included
+    json_buffer = "{\"id\": 12, \"level\": 3, \"tags\": 2.5, \"other\": 1.5}";
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+#ifdef JSON_INCITER_STATS
+    json_inciter_stats_t stats;
+    json_inciter_stats_reset();
+    assert_int_equal(json_inciter_bind_object(object, device_fields, 2, &device, NULL), JSON_INCITER_OK);
+    json_inciter_stats_snapshot(&stats);
+    assert_int_equal(stats.number_conversions, 0);
+#endif
+    assert_int_equal(json_inciter_bind_object(object, device_fields, 7, &device, NULL), JSON_INCITER_DONE);
+    assert_int_equal(device.id, 12);
+    assert_int_equal(device.tags.tag, JSON_INCITER_ELEMENT_TAG_NUMBER);
+    assert_int_equal(device.tags.flags, 0);
+    assert_true(device.tags.as.number == 2.5);
+}
+
+
+static void test_json_inciter_copy_string(void **state) {
+    (void)state;
+    json_inciter_element_t element = {0};
+    char                   destination[160];
+    size_t                 required = 0;
+
+    const char *json_buffer = "\"a\\\"b\\\\c\\/d\\b\\f\\n\\r\\t\\u0041\\u00e9\\u20ac\\ud83d\\ude00\"";
+    assert_int_equal(json_inciter_parse_value(json_buffer, &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_copy_string(destination, sizeof(destination), element, &required), JSON_INCITER_OK);
+    assert_string_equal(destination, "a\"b\\c/d\b\f\n\r\tA\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+    assert_int_equal(required, strlen(destination) + 1);
+
+    // The size needed is reported when the buffer is too small, an exact fit is enough
+    assert_int_equal(json_inciter_copy_string(destination, 5, element, &required), JSON_INCITER_OVERFLOW);
+    assert_int_equal(required, 23);
+    assert_int_equal(json_inciter_copy_string(destination, 0, element, &required), JSON_INCITER_OVERFLOW);
+    assert_int_equal(json_inciter_copy_string(destination, 23, element, NULL), JSON_INCITER_OK);
+
+    // Lone surrogates have no UTF-8 form and are replaced
+    const char *lone[][2] = {
+        {"\"\\ud800\"", "\xef\xbf\xbd"},
+        {"\"\\udc00\"", "\xef\xbf\xbd"},
+        {"\"\\ud800x\"", "\xef\xbf\xbdx"},
+        {"\"\\ud800\\u0041\"", "\xef\xbf\xbd" "A"},
+        {"\"\\ude00\\ud83d\"", "\xef\xbf\xbd\xef\xbf\xbd"},
+        {"\"\\ud83d\\ude00\\udfff\"", "\xf0\x9f\x98\x80\xef\xbf\xbd"},
+    };
+    for (size_t i = 0; i < sizeof(lone) / sizeof(lone[0]); i++) {
+        assert_int_equal(json_inciter_parse_value(lone[i][0], &element), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_copy_string(destination, sizeof(destination), element, NULL), JSON_INCITER_OK);
+        assert_string_equal(destination, lone[i][1]);
+    }
+
+    // Invalid escapes and elements
+    const char *invalid[] = {"\"\\x\"", "\"\\u12\"", "\"\\u12G4\""};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        assert_int_equal(json_inciter_parse_value(invalid[i], &element), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_copy_string(destination, sizeof(destination), element, NULL),
+                         JSON_INCITER_INVALID);
+    }
+    assert_int_equal(json_inciter_parse_value("12", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_copy_string(destination, sizeof(destination), element, NULL), JSON_INCITER_INVALID);
+
+    // Escapes at every position of the vectorized blocks
+    for (size_t length = 0; length < 70; length++) {
+        for (size_t position = 0; position <= length; position++) {
+            char json[80];
+            char expected[80];
+            json[0] = '"';
+            for (size_t i = 0; i < length; i++) {
+                json[1 + i] = expected[i] = (char)('a' + i % 26);
+            }
+            memcpy(&json[1 + length], "\"", 2);
+            expected[length] = '\0';
+            if (position + 1 < length) {
+                json[1 + position]     = '\\';
+                json[1 + position + 1] = 'n';
+                expected[position]     = '\n';
+                memmove(&expected[position + 1], &expected[position + 2], length - position - 1);
+            }
+            assert_int_equal(json_inciter_parse_value(json, &element), JSON_INCITER_OK);
+            assert_int_equal(json_inciter_copy_string(destination, sizeof(destination), element, NULL),
+                             JSON_INCITER_OK);
+            assert_string_equal(destination, expected);
+        }
+    }
+
+    // In place
+    char mutable_buffer[] = "{\"key\": \"caf\\u00e9 \\\"au lait\\\"\"}";
+    json_inciter_element_t object         = {0};
+    assert_int_equal(json_inciter_parse_value(mutable_buffer, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_find_value_in_object(object, "key", &element), JSON_INCITER_OK);
+    size_t unescaped_len = 0;
+    assert_int_equal(json_inciter_unescape_in_place((char *)element.as.string, JSON_INCITER_STRING_LENGTH(element),
+                                                    &unescaped_len),
+                     JSON_INCITER_OK);
+    assert_int_equal(unescaped_len, strlen("caf\xc3\xa9 \"au lait\""));
+    assert_string_equal(element.as.string, "caf\xc3\xa9 \"au lait\"");
+
+    // Raw copies start at the content and accept an exact fit
+    assert_int_equal(json_inciter_parse_value("\"a\\nb\"", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_copy_content(destination, 5, element), 0);
+    assert_string_equal(destination, "a\\nb");
+    assert_int_equal(json_inciter_copy_content(destination, 4, element), (uint8_t)-1);
+}
+
+
+static void test_json_inciter_validate(void **state) {
+    (void)state;
+
+    const char *valid[] = {
+        "null", " true ", "-0.5e+3", "\"\"", "[]", "{}", "[1, [2, {\"a\": [null, false]}], \"x\"]",
+        "{\"a\": {\"b\": {}}, \"c\": [ ], \"d\": \"\\u00e9\\n\\\"\"}", "\"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\"",
+        "\"\xed\x9f\xbf \xf4\x8f\xbf\xbf \xe0\xa0\x80\"",
+        "\"a long enough string to go through the vectorized checks\"",
+    };
+    for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+        assert_int_equal(json_inciter_validate(valid[i]), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_validate_n(valid[i], strlen(valid[i])), JSON_INCITER_OK);
+    }
+
+    const char *invalid[] = {
+        "nulx", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\": 1,}", "{1: 2}", "[}", "{]", "01", "[1.]", "-a", "1e,", "+1",
+        "[1] 2", "\"\\x\"", "\"\\u12G4\"", "\"tab\there\"", "\"\x80\"", "\"\xc0\xaf\"", "\"\xe0\x80\xaf\"",
+        "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"", "\"\xf5\x80\x80\x80\"", "\"\xc3\x28\"", "[1]]",
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        assert_int_equal(json_inciter_validate(invalid[i]), JSON_INCITER_INVALID);
+    }
+
+    const char *incomplete[] = {
+        "", "  ", "nul", "1.", "[1, 2", "{\"a\": ", "{\"a\"", "\"abc", "\"\\u12", "\"\xe2\x82", "[[]",
+    };
+    for (size_t i = 0; i < sizeof(incomplete) / sizeof(incomplete[0]); i++) {
+        assert_int_equal(json_inciter_validate(incomplete[i]), JSON_INCITER_INCOMPLETE);
+    }
+    assert_int_equal(json_inciter_validate_n("[1, 2] ", 4), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_validate_n("\"abc\"", 4), JSON_INCITER_INCOMPLETE);
+
+    // Escapes cut by the end of an unterminated buffer are not read past it
+    for (size_t i = 0; i < sizeof(incomplete) / sizeof(incomplete[0]); i++) {
+        size_t length = 0;
+        char  *buffer = unterminated_copy(incomplete[i], &length);
+        assert_int_equal(json_inciter_validate_n(buffer, length), JSON_INCITER_INCOMPLETE);
+        free(buffer);
+    }
+    const char *truncated_escapes[] = {"\"\\", "\"\\u", "\"\\u1", "\"\\u12", "\"\\u123", "[\"\\u00e"};
+    for (size_t i = 0; i < sizeof(truncated_escapes) / sizeof(truncated_escapes[0]); i++) {
+        size_t length = 0;
+        char  *buffer = unterminated_copy(truncated_escapes[i], &length);
+        assert_int_equal(json_inciter_validate_n(buffer, length), JSON_INCITER_INCOMPLETE);
+        free(buffer);
+    }
+
+    // Nesting is limited
+    char nested[2 * JSON_INCITER_MAX_DEPTH + 3];
+    memset(nested, '[', JSON_INCITER_MAX_DEPTH);
+    memset(&nested[JSON_INCITER_MAX_DEPTH], ']', JSON_INCITER_MAX_DEPTH);
+    nested[2 * JSON_INCITER_MAX_DEPTH] = '\0';
+    assert_int_equal(json_inciter_validate(nested), JSON_INCITER_OK);
+    memmove(&nested[1], nested, 2 * JSON_INCITER_MAX_DEPTH + 1);
+    nested[0] = '[';
+    strcat(nested, "]");
+    assert_int_equal(json_inciter_validate(nested), JSON_INCITER_OVERFLOW);
+
+    // Trusted functions read validated buffers like the regular ones
+    const char *json_buffer =
+        "{\"id\": 42, \"name\": \"a \\\"b\\\"\", \"tags\": [true, null, 1.5e1], \"x\": {\"y\": false}}";
+    assert_int_equal(json_inciter_validate(json_buffer), JSON_INCITER_OK);
+
+    json_inciter_element_t object = {0};
+    json_inciter_element_t trusted = {0};
+    json_inciter_element_t element = {0};
+    assert_int_equal(json_inciter_parse_value(json_buffer, &object), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_parse_value_trusted(json_buffer, &trusted), JSON_INCITER_OK);
+    assert_int_equal(trusted.tag, JSON_INCITER_ELEMENT_TAG_OBJECT);
+    assert_int_equal(trusted.length, object.length);
+
+    const char *keys[] = {"id", "name", "tags", "x"};
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        json_inciter_element_t expected = {0};
+        assert_int_equal(json_inciter_find_value_in_object(object, keys[i], &expected), JSON_INCITER_OK);
+        assert_int_equal(json_inciter_find_value_in_object_trusted(trusted, keys[i], &element), JSON_INCITER_OK);
+        assert_int_equal(element.tag, expected.tag);
+        assert_ptr_equal(element.start, expected.start);
+        assert_int_equal(element.length, expected.length);
+    }
+    assert_int_equal(json_inciter_find_value_in_object_trusted(trusted, "missing", &element), JSON_INCITER_DONE);
+
+    assert_int_equal(json_inciter_find_value_in_object_trusted(trusted, "tags", &element), JSON_INCITER_OK);
+    const char                    *next   = json_inciter_element_content_start(element);
+    const json_inciter_element_tag_t tags[] = {JSON_INCITER_ELEMENT_TAG_TRUE, JSON_INCITER_ELEMENT_TAG_NULL,
+                                               JSON_INCITER_ELEMENT_TAG_NUMBER};
+    size_t                         count  = 0;
+    do {
+        assert_int_equal(json_inciter_parse_value_trusted(next, &element), JSON_INCITER_OK);
+        assert_int_equal(element.tag, tags[count++]);
+        next = JSON_INCITER_ELEMENT_NEXT_START(element);
+    } while (json_inciter_next_element_start_trusted(next, &next) == JSON_INCITER_OK);
+    assert_int_equal(count, 3);
+    assert_true(element.as.number == 15.0);
+
+    // Past the last member, and in empty containers, there is nothing to parse
+    assert_int_equal(json_inciter_parse_value_trusted(next, &element), JSON_INCITER_DONE);
+    assert_true(element.as.number == 15.0);
+    const char *empty[] = {"[]", "[ ]", "{}", "{\n}"};
+    for (size_t i = 0; i < sizeof(empty) / sizeof(empty[0]); i++) {
+        assert_int_equal(json_inciter_parse_value_trusted(empty[i], &trusted), JSON_INCITER_OK);
+        next = json_inciter_element_content_start(trusted);
+        assert_int_equal(json_inciter_parse_value_trusted(next, &element), JSON_INCITER_DONE);
+    }
+    assert_int_equal(json_inciter_parse_value_trusted("[[], {}]", &trusted), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_parse_value_trusted(json_inciter_element_content_start(trusted), &element),
+                     JSON_INCITER_OK);
+    next = json_inciter_element_content_start(element);
+    assert_int_equal(json_inciter_parse_value_trusted(next, &element), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_parse_value_trusted("", &element), JSON_INCITER_DONE);
+
+    // The trusted iterator gives the members the checked one does, lazy containers being skipped on demand
+    const char *documents[] = {"[]", "{ }", "[1, [2, {\"a\": []}], \"x\" , {}]",
+                               "{\"a\" : {\"b\": [1]}, \"c\":[], \"d\": \"e\"}"};
+    const uint8_t modes[]   = {0, JSON_INCITER_FLAG_LAZY_CONTAINERS};
+    for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); i++) {
+        for (size_t mode = 0; mode < sizeof(modes) / sizeof(modes[0]); mode++) {
+            json_inciter_iter_t    iter;
+            json_inciter_iter_t    checked_iter;
+            json_inciter_element_t checked     = {0};
+            json_inciter_element_t checked_key = {0};
+            json_inciter_element_t key         = {0};
+            json_inciter_t         result;
+
+            assert_int_equal(json_inciter_parse_value_trusted(documents[i], &trusted), JSON_INCITER_OK);
+            json_inciter_iter_init(&checked_iter, trusted);
+            json_inciter_iter_init(&iter, trusted);
+            checked.flags = modes[mode];
+            element.flags = modes[mode];
+            do {
+                result = json_inciter_iter_next(&checked_iter, &checked_key, &checked);
+                assert_int_equal(json_inciter_iter_next_trusted(&iter, &key, &element), result);
+                if (result == JSON_INCITER_OK) {
+                    assert_int_equal(element.tag, checked.tag);
+                    assert_ptr_equal(element.start, checked.start);
+                    assert_ptr_equal(key.start, checked_key.start);
+                }
+            } while (result == JSON_INCITER_OK);
+            assert_int_equal(iter.offset, checked_iter.offset);
+            assert_int_equal(json_inciter_iter_next_trusted(&iter, &key, &element), JSON_INCITER_DONE);
+        }
+    }
+}
+
+
+#ifdef JSON_INCITER_THREADS
+typedef struct {
+    size_t  records;
+    size_t  invalid;
+    int64_t sum;
+    int64_t last_id;
+    uint8_t in_order;
+} test_records_context_t;
+
+static json_inciter_t test_records_callback(void *context, json_inciter_t result,
+                                            const json_inciter_element_t *record) {
+    test_records_context_t *totals = context;
+    json_inciter_element_t  id     = {0};
+    int64_t                 value  = 0;
+
+    if (result != JSON_INCITER_OK) {
+        totals->invalid++;
+        return JSON_INCITER_OK;
+    }
+    if (json_inciter_find_value_in_object(*record, "id", &id) != JSON_INCITER_OK ||
+        json_inciter_element_as_int64(id, &value) != JSON_INCITER_OK) {
+        return JSON_INCITER_INVALID;
+    }
+    totals->in_order &= value > totals->last_id;
+    totals->last_id = value;
+    totals->sum += value;
+    totals->records++;
+    return JSON_INCITER_OK;
+}
+#endif
+
+
+static void test_json_inciter_records(void **state) {
+    (void)state;
+    json_inciter_records_t records = {0};
+    json_inciter_element_t element = {0};
+
+    // Blank lines, CRLF, a malformed record, trailing garbage and a last line without newline
+    const char *json_buffer = "{\"a\": 1}\n\n  \r\n[1, 2]\r\n{\"a\": \n\"x\" y\n42\n  true  \n-1.5";
+    const json_inciter_t     results[] = {JSON_INCITER_OK, JSON_INCITER_OK, JSON_INCITER_INCOMPLETE,
+                                          JSON_INCITER_INVALID, JSON_INCITER_OK, JSON_INCITER_OK, JSON_INCITER_OK};
+    const size_t             lines[]   = {1, 4, 5, 6, 7, 8, 9};
+    for (uint8_t bounded = 0; bounded < 2; bounded++) {
+        if (bounded) {
+            json_inciter_records_init_n(&records, json_buffer, strlen(json_buffer));
+        } else {
+            json_inciter_records_init(&records, json_buffer);
+        }
+        for (size_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) {
+            assert_int_equal(json_inciter_records_next(&records, &element), results[i]);
+            assert_int_equal(records.line, lines[i]);
+        }
+        assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_NUMBER);
+        assert_true(element.as.number == -1.5);
+        assert_int_equal(json_inciter_records_next(&records, &element), JSON_INCITER_DONE);
+        assert_int_equal(json_inciter_records_next(&records, &element), JSON_INCITER_DONE);
+    }
+
+    // Lazy records are bounded by their line
+    json_inciter_records_init(&records, "[1, 2\n[3]\n");
+    element.flags = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_records_next(&records, &element), JSON_INCITER_OK);
+    assert_null(json_inciter_element_next_start(&element));
+    assert_int_equal(json_inciter_records_next(&records, &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_element_resolve(&element), JSON_INCITER_OK);
+    assert_int_equal(element.length, 3);
+
+    // Ranges start on record boundaries and cover the whole buffer
+    char   log[4096];
+    size_t length = 0;
+    for (int64_t id = 1; length < sizeof(log) - 64; id++) {
+        length += (size_t)snprintf(&log[length], sizeof(log) - length, "{\"id\": %lld, \"pad\": \"%.*s\"}\n",
+                                   (long long)id, (int)(id % 37), "....................................");
+    }
+    for (size_t n_ranges = 1; n_ranges < 40; n_ranges += 3) {
+        size_t bounds[41];
+        size_t total = 0;
+        json_inciter_records_partition_n(log, length, n_ranges, bounds);
+        assert_int_equal(bounds[0], 0);
+        assert_int_equal(bounds[n_ranges], length);
+        for (size_t i = 0; i < n_ranges; i++) {
+            assert_true(bounds[i] <= bounds[i + 1]);
+            assert_true(bounds[i] == 0 || log[bounds[i] - 1] == '\n');
+            json_inciter_records_init_n(&records, &log[bounds[i]], bounds[i + 1] - bounds[i]);
+            element.flags = 0;
+            while (json_inciter_records_next(&records, &element) == JSON_INCITER_OK) {
+                total++;
+            }
+        }
+        json_inciter_records_init_n(&records, log, length);
+        while (json_inciter_records_next(&records, &element) == JSON_INCITER_OK) {
+            total--;
+        }
+        assert_int_equal(total, 0);
+    }
+
+#ifdef JSON_INCITER_THREADS
+    // Every record is seen once, in order within each context when requested
+    json_inciter_records_init_n(&records, log, length);
+    int64_t expected_sum = 0;
+    size_t  n_records    = 0;
+    while (json_inciter_records_next(&records, &element) == JSON_INCITER_OK) {
+        n_records++;
+        expected_sum += (int64_t)n_records;
+    }
+    for (uint8_t ordered = 0; ordered < 2; ordered++) {
+        test_records_context_t totals[4] = {{0}};
+        void                  *contexts[4];
+        size_t                 seen = 0;
+        int64_t                sum  = 0;
+        int64_t                last = 0;
+        for (size_t i = 0; i < 4; i++) {
+            totals[i].in_order = 1;
+            contexts[i]        = &totals[i];
+        }
+        assert_int_equal(json_inciter_records_parallel_n(log, length, JSON_INCITER_FLAG_LAZY_NUMBERS, 4, ordered,
+                                                         test_records_callback, contexts),
+                         JSON_INCITER_OK);
+        for (size_t i = 0; i < 4; i++) {
+            seen += totals[i].records;
+            sum += totals[i].sum;
+            if (ordered && totals[i].records > 0) {
+                assert_true(totals[i].in_order);
+                assert_true(totals[i].last_id > last);
+                last = totals[i].last_id;
+            }
+        }
+        assert_int_equal(seen, n_records);
+        assert_int_equal(sum, expected_sum);
+    }
+
+    // A failing callback is reported
+    test_records_context_t totals[2] = {{0}};
+    void                  *contexts[2] = {&totals[0], &totals[1]};
+    assert_int_equal(json_inciter_records_parallel_n("{\"id\": 1}\n{}\n", 13, 0, 2, 1, test_records_callback,
+                                                     contexts),
+                     JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_records_parallel_n(log, length, 0, JSON_INCITER_MAX_THREADS + 1, 1,
+                                                     test_records_callback, contexts),
+                     JSON_INCITER_OVERFLOW);
+#endif
+}
+
+
+static void test_json_inciter_array_partition(void **state) {
+    (void)state;
+    json_inciter_element_t array   = {0};
+    json_inciter_element_t element = {0};
+
+    // Commas, brackets, quotes and backslashes inside strings and nested containers, across vectorized blocks
+    char   json_buffer[8192];
+    size_t length = 0;
+    json_buffer[length++] = '[';
+    for (int id = 1; length < sizeof(json_buffer) - 128; id++) {
+        length += (size_t)snprintf(&json_buffer[length], sizeof(json_buffer) - length,
+                                   "%s{\"id\": %d, \"s\": \"a, ] } \\\" [ {%.*s\\\\\", "
+                                   "\"n\": [[%d, {\"x\": \",\"}], []]}",
+                                   id > 1 ? (id % 3 ? ", " : ",\n ") : " ", id, id % 70,
+                                   "..................................................................,,,,",
+                                   id);
+    }
+    memcpy(&json_buffer[length], " ]", 3);
+    length += 2;
+
+    assert_int_equal(json_inciter_parse_value(json_buffer, &array), JSON_INCITER_OK);
+    size_t n_elements = 0;
+    size_t offset     = 1;
+    while (json_inciter_array_range_next(array.start, array.length - 1, &offset, &element) == JSON_INCITER_OK) {
+        n_elements++;
+    }
+    assert_int_equal(offset, array.length - 1);
+
+    for (size_t n_ranges = 1; n_ranges < 64; n_ranges += 5) {
+        size_t bounds[65];
+        size_t seen = 0;
+        assert_int_equal(json_inciter_array_partition(array, n_ranges, bounds), JSON_INCITER_OK);
+        assert_int_equal(bounds[0], 1);
+        assert_int_equal(bounds[n_ranges], array.length - 1);
+        for (size_t i = 0; i < n_ranges; i++) {
+            assert_true(bounds[i] <= bounds[i + 1]);
+            assert_true(i == 0 || bounds[i] == bounds[n_ranges] || json_buffer[bounds[i] - 1] == ',');
+
+            json_inciter_t result;
+            offset = bounds[i];
+            while ((result = json_inciter_array_range_next(array.start, bounds[i + 1], &offset, &element)) ==
+                   JSON_INCITER_OK) {
+                json_inciter_element_t id = {0};
+                int64_t                value = 0;
+                assert_int_equal(json_inciter_find_value_in_object(element, "id", &id), JSON_INCITER_OK);
+                assert_int_equal(json_inciter_element_as_int64(id, &value), JSON_INCITER_OK);
+                assert_int_equal(value, (int64_t)++seen);
+            }
+            assert_int_equal(result, JSON_INCITER_DONE);
+        }
+        assert_int_equal(seen, n_elements);
+    }
+
+    // Small and empty arrays, lazy arrays, other elements
+    size_t bounds[5];
+    assert_int_equal(json_inciter_parse_value(" [ ] ", &array), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_array_partition(array, 4, bounds), JSON_INCITER_OK);
+    offset = bounds[0];
+    assert_int_equal(json_inciter_array_range_next(array.start, bounds[4], &offset, &element), JSON_INCITER_DONE);
+
+    array.flags = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_parse_value("[1,2,3] ", &array), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_array_partition(array, 4, bounds), JSON_INCITER_OK);
+    assert_int_equal(bounds[2], 5);
+    assert_int_equal(bounds[3], 6);
+    offset = bounds[2];
+    assert_int_equal(json_inciter_array_range_next(array.start, bounds[4], &offset, &element), JSON_INCITER_OK);
+    assert_true(element.as.number == 3.0);
+    assert_int_equal(json_inciter_parse_value("[1, {\"a\": ]}, 3]", &array), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_array_partition(array, 4, bounds), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_parse_value("{}", &array), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_array_partition(array, 4, bounds), JSON_INCITER_INVALID);
+
+#ifdef JSON_INCITER_THREADS
+    assert_int_equal(json_inciter_parse_value(json_buffer, &array), JSON_INCITER_OK);
+    for (uint8_t ordered = 0; ordered < 2; ordered++) {
+        test_records_context_t totals[3] = {{0}};
+        void                  *contexts[3];
+        size_t                 seen = 0;
+        int64_t                sum  = 0;
+        for (size_t i = 0; i < 3; i++) {
+            totals[i].in_order = 1;
+            contexts[i]        = &totals[i];
+        }
+        assert_int_equal(json_inciter_array_parallel(array, 0, 3, ordered, test_records_callback, contexts),
+                         JSON_INCITER_OK);
+        for (size_t i = 0; i < 3; i++) {
+            seen += totals[i].records;
+            sum += totals[i].sum;
+            assert_true(!ordered || totals[i].in_order);
+        }
+        assert_int_equal(seen, n_elements);
+        assert_int_equal(sum, (int64_t)(n_elements * (n_elements + 1) / 2));
+    }
+#endif
+}
+
+
+// Walk a segmented container, appending every key and scalar to `out`
+static json_inciter_t test_segments_walk(json_inciter_segments_t *segments, char *out, size_t *out_len) {
+    json_inciter_element_tag_t tag;
+    json_inciter_t             result = json_inciter_segments_enter(segments, &tag);
+
+    if (result != JSON_INCITER_OK) {
+        return result;
+    }
+    out[(*out_len)++] = tag == JSON_INCITER_ELEMENT_TAG_ARRAY ? '[' : '{';
+
+    do {
+        json_inciter_element_t     element = {0};
+        json_inciter_element_tag_t nested;
+
+        if (tag == JSON_INCITER_ELEMENT_TAG_OBJECT) {
+            if ((result = json_inciter_segments_parse_key(segments, &element)) == JSON_INCITER_DONE) {
+                break;
+            } else if (result != JSON_INCITER_OK || element.tag != JSON_INCITER_ELEMENT_TAG_STRING) {
+                return JSON_INCITER_INVALID;
+            }
+            memcpy(&out[*out_len], element.start, element.length);
+            *out_len += element.length;
+            out[(*out_len)++] = ':';
+        }
+
+        // Containers are entered, scalars parsed whole
+        json_inciter_segments_t peek = *segments;
+        if (json_inciter_segments_enter(&peek, &nested) == JSON_INCITER_OK) {
+            if ((result = test_segments_walk(segments, out, out_len)) != JSON_INCITER_OK) {
+                return result;
+            }
+        } else if ((result = json_inciter_segments_parse_value(segments, &element)) == JSON_INCITER_DONE) {
+            break;
+        } else if (result != JSON_INCITER_OK) {
+            return result;
+        } else {
+            out[*out_len]     = (char)('0' + element.tag);
+            *out_len += 1;
+            memcpy(&out[*out_len], element.start, element.length);
+            *out_len += element.length;
+        }
+        out[(*out_len)++] = ',';
+    } while ((result = json_inciter_segments_next_element_start(segments, tag)) == JSON_INCITER_OK);
+
+    out[(*out_len)++] = tag == JSON_INCITER_ELEMENT_TAG_ARRAY ? ']' : '}';
+    return result == JSON_INCITER_INVALID || result == JSON_INCITER_INCOMPLETE ? result : JSON_INCITER_OK;
+}
+
+
+static void test_json_inciter_segments(void **state) {
+    (void)state;
+    const char *json_buffer = " {\"name\": \"a \\\"quoted\\\" \\\\ string \\u00e9\", \"n\": -12.5e3, \"ok\": true, "
+                              "\"none\": null, \"list\": [1, [], {}, [2, \"x]\", {\"deep\": [false]}], 12345678901234], "
+                              "\"object\": {\"k\\\\\": \"v\", \"empty\": {}}, \"last\": 0} ";
+    size_t      length      = strlen(json_buffer);
+    char        expected[1024];
+    size_t      expected_len = 0;
+    char        scratch[256];
+
+    json_inciter_segment_t  list[512];
+    json_inciter_segments_t segments;
+
+    // Reference: a single segment, nothing is copied
+    list[0].buffer = json_buffer;
+    list[0].length = length;
+    json_inciter_segments_init(&segments, list, 1, NULL, 0);
+    assert_int_equal(test_segments_walk(&segments, expected, &expected_len), JSON_INCITER_OK);
+    assert_false(segments.copied);
+
+    // Every split in two segments, then segments of every size up to 8 bytes, with empty ones in between
+    for (size_t split = 0; split < length + 8; split++) {
+        size_t n_segments = 0;
+        size_t position   = 0;
+        char   out[1024];
+        size_t out_len = 0;
+
+        while (position < length) {
+            size_t size = split <= length ? (n_segments == 0 ? split : length) : split - length;
+            if (size > length - position) {
+                size = length - position;
+            }
+            list[n_segments].buffer   = &json_buffer[position];
+            list[n_segments++].length = size;
+            list[n_segments].buffer   = &json_buffer[position + size];
+            list[n_segments++].length = 0;
+            position += size;
+        }
+        json_inciter_segments_init(&segments, list, n_segments, scratch, sizeof(scratch));
+        assert_int_equal(test_segments_walk(&segments, out, &out_len), JSON_INCITER_OK);
+        assert_int_equal(out_len, expected_len);
+        assert_memory_equal(out, expected, expected_len);
+    }
+
+    // A straddling element reports the scratch it needs and can be retried
+    json_inciter_element_t element = {0};
+    list[0].buffer = "[\"abcdef\", 1";
+    list[0].length = 5;
+    list[1].buffer = &list[0].buffer[5];
+    list[1].length = 7;
+    json_inciter_segments_init(&segments, list, 2, scratch, 4);
+    json_inciter_element_tag_t tag;
+    assert_int_equal(json_inciter_segments_enter(&segments, &tag), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_segments_parse_value(&segments, &element), JSON_INCITER_OVERFLOW);
+    assert_int_equal(segments.required, 8);
+    segments.scratch_size = sizeof(scratch);
+    assert_int_equal(json_inciter_segments_parse_value(&segments, &element), JSON_INCITER_OK);
+    assert_true(segments.copied);
+    assert_ptr_equal(element.start, scratch);
+    assert_int_equal(json_inciter_segments_next_element_start(&segments, tag), JSON_INCITER_OK);
+
+    // A number ending the stream may go on, the stream can grow after an incomplete result
+    size_t offset = segments.offset;
+    assert_int_equal(json_inciter_segments_parse_value(&segments, &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(segments.segment, 1);
+    assert_int_equal(segments.offset, offset);
+    list[2].buffer      = " ]";
+    list[2].length      = 2;
+    segments.n_segments = 3;
+    assert_int_equal(json_inciter_segments_parse_value(&segments, &element), JSON_INCITER_OK);
+    assert_false(segments.copied);
+    assert_true(element.as.number == 1.0);
+    assert_int_equal(json_inciter_segments_next_element_start(&segments, tag), JSON_INCITER_DONE);
+
+    // Segments starting with a byte that cannot start a value are invalid, whatever follows
+    const char *bad_starts[] = {"x", ":", "+1", "\x80"};
+    for (size_t i = 0; i < sizeof(bad_starts) / sizeof(bad_starts[0]); i++) {
+        list[0].buffer = bad_starts[i];
+        list[0].length = strlen(bad_starts[i]);
+        list[1].buffer = "ue]";
+        list[1].length = 3;
+        json_inciter_segments_init(&segments, list, 2, scratch, sizeof(scratch));
+        assert_int_equal(json_inciter_segments_parse_value(&segments, &element), JSON_INCITER_INVALID);
+        assert_int_equal(segments.offset, 0);
+    }
+
+    // Likewise when a segment boundary splits the number
+    list[0].buffer = "[12";
+    list[0].length = 3;
+    json_inciter_segments_init(&segments, list, 1, scratch, sizeof(scratch));
+    assert_int_equal(json_inciter_segments_enter(&segments, &tag), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_segments_parse_value(&segments, &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(segments.offset, 1);
+    list[1].buffer      = "345]";
+    list[1].length      = 4;
+    segments.n_segments = 2;
+    assert_int_equal(json_inciter_segments_parse_value(&segments, &element), JSON_INCITER_OK);
+    assert_true(segments.copied);
+    assert_true(element.as.number == 12345.0);
+    assert_int_equal(json_inciter_segments_next_element_start(&segments, tag), JSON_INCITER_DONE);
+
+    list[0].buffer = "{\"a\" 1}";
+    list[0].length = 7;
+    json_inciter_segments_init(&segments, list, 1, NULL, 0);
+    assert_int_equal(json_inciter_segments_enter(&segments, &tag), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_segments_parse_key(&segments, &element), JSON_INCITER_INVALID);
+}
+
+
+typedef struct {
+    char        out[256];
+    size_t      out_len;
+    const char *skip;       // Key whose value, or container starting with this character, is skipped
+    size_t      stop;       // Events before the walk is stopped, 0 for all
+    size_t      events;
+} test_walk_context_t;
+
+
+// Append every event to the context, as its bracket or its source text
+static json_inciter_action_t test_walk_callback(void *context, json_inciter_event_t event,
+                                                const json_inciter_element_t *element) {
+    test_walk_context_t *walk = context;
+
+    if (walk->stop > 0 && ++walk->events > walk->stop) {
+        return JSON_INCITER_ACTION_STOP;
+    }
+    if (walk->out_len + element->length + 3 < sizeof(walk->out)) {
+        if (event == JSON_INCITER_EVENT_KEY) {
+            walk->out[walk->out_len++] = 'k';
+        }
+        memcpy(&walk->out[walk->out_len], element->start, element->length);
+        walk->out_len += element->length;
+        walk->out[walk->out_len++] = ' ';
+        walk->out[walk->out_len]   = '\0';
+    }
+
+    if (event == JSON_INCITER_EVENT_KEY && strncmp(walk->skip, element->as.string, strlen(walk->skip)) == 0) {
+        return JSON_INCITER_ACTION_SKIP;
+    } else if ((event == JSON_INCITER_EVENT_BEGIN_ARRAY || event == JSON_INCITER_EVENT_BEGIN_OBJECT) &&
+               walk->skip[0] == element->start[0]) {
+        return JSON_INCITER_ACTION_SKIP;
+    }
+    return JSON_INCITER_ACTION_CONTINUE;
+}
+
+
+static void test_json_inciter_walk(void **state) {
+    (void)state;
+    const char *json_buffer =
+        " {\"a\": [1, \"x]\", {\"b\": null}, []], \"c\": {\"d\": [true, -2.5e1]}, \"e\": {}} ";
+    test_walk_context_t walk = {.skip = "-"};
+
+    assert_int_equal(json_inciter_walk(json_buffer, 0, test_walk_callback, &walk), JSON_INCITER_OK);
+    assert_string_equal(walk.out,
+                        "{ k\"a\" [ 1 \"x]\" { k\"b\" null } [ ] ] k\"c\" { k\"d\" [ true -2.5e1 ] } k\"e\" { } } ");
+
+    // Skipping a key skips its value, skipping a container skips it up to its end
+    walk = (test_walk_context_t){.skip = "c"};
+    assert_int_equal(json_inciter_walk(json_buffer, 0, test_walk_callback, &walk), JSON_INCITER_OK);
+    assert_string_equal(walk.out, "{ k\"a\" [ 1 \"x]\" { k\"b\" null } [ ] ] k\"c\" k\"e\" { } } ");
+    walk = (test_walk_context_t){.skip = "["};
+    assert_int_equal(json_inciter_walk(json_buffer, 0, test_walk_callback, &walk), JSON_INCITER_OK);
+    assert_string_equal(walk.out, "{ k\"a\" [ k\"c\" { k\"d\" [ } k\"e\" { } } ");
+
+    walk = (test_walk_context_t){.skip = "-", .stop = 3};
+    assert_int_equal(json_inciter_walk(json_buffer, 0, test_walk_callback, &walk), JSON_INCITER_DONE);
+    assert_string_equal(walk.out, "{ k\"a\" [ ");
+
+    // Scalars are parsed in the requested mode
+    walk = (test_walk_context_t){.skip = "-"};
+    assert_int_equal(json_inciter_walk_n("[12.5e1]", 8, JSON_INCITER_FLAG_LAZY_NUMBERS, test_walk_callback, &walk),
+                     JSON_INCITER_OK);
+    assert_string_equal(walk.out, "[ 12.5e1 ] ");
+    walk = (test_walk_context_t){.skip = "-"};
+    assert_int_equal(json_inciter_walk("\"top\"", 0, test_walk_callback, &walk), JSON_INCITER_OK);
+    assert_string_equal(walk.out, "\"top\" ");
+
+    // Only the top level value ends with the buffer, a number cut inside a container is not reported
+    walk = (test_walk_context_t){.skip = "-"};
+    assert_int_equal(json_inciter_walk_n("[125]", 3, 0, test_walk_callback, &walk), JSON_INCITER_INCOMPLETE);
+    assert_string_equal(walk.out, "[ ");
+    walk = (test_walk_context_t){.skip = "-"};
+    assert_int_equal(json_inciter_walk_n("125", 2, 0, test_walk_callback, &walk), JSON_INCITER_OK);
+    assert_string_equal(walk.out, "12 ");
+
+    const char *invalid[]    = {"[1 2]", "{\"a\" 1}", "{1: 2}", "[1,]", "{\"a\": [}", "[tru]", "]"};
+    const char *incomplete[] = {"", "[", "{\"a\": ", "[1, {\"b\": [2", "{\"a\"", "\"ab"};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        walk = (test_walk_context_t){.skip = "-"};
+        assert_int_equal(json_inciter_walk(invalid[i], 0, test_walk_callback, &walk), JSON_INCITER_INVALID);
+    }
+    for (size_t i = 0; i < sizeof(incomplete) / sizeof(incomplete[0]); i++) {
+        walk = (test_walk_context_t){.skip = "-"};
+        assert_int_equal(json_inciter_walk(incomplete[i], 0, test_walk_callback, &walk), JSON_INCITER_INCOMPLETE);
+        walk = (test_walk_context_t){.skip = "["};
+        assert_int_equal(json_inciter_walk(incomplete[i], 0, test_walk_callback, &walk), JSON_INCITER_INCOMPLETE);
+    }
+
+    // Deep nesting is bounded, whatever the stack
+    static char deep[JSON_INCITER_MAX_DEPTH + 2];
+    memset(deep, '[', sizeof(deep) - 1);
+    walk = (test_walk_context_t){.skip = "-"};
+    assert_int_equal(json_inciter_walk(deep, 0, test_walk_callback, &walk), JSON_INCITER_OVERFLOW);
+    walk = (test_walk_context_t){.skip = "-"};
+    assert_int_equal(json_inciter_walk_n(deep, 2, 0, test_walk_callback, &walk), JSON_INCITER_INCOMPLETE);
+}
+
+
+static void test_json_inciter_iter(void **state) {
+    (void)state;
+    json_inciter_element_t container = {0};
+    json_inciter_element_t key       = {0};
+    json_inciter_element_t value     = {0};
+    json_inciter_iter_t    iter;
+
+    assert_int_equal(json_inciter_parse_value(" { \"a\" : 1 ,\"b\":[2, {\"c\": \"]\"}], \"\\\"\": {} } x", &container),
+                     JSON_INCITER_OK);
+    assert_int_equal(json_inciter_iter_init(&iter, container), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_iter_next(&iter, &key, &value), JSON_INCITER_OK);
+    assert_memory_equal(key.start, "\"a\"", key.length);
+    assert_true(value.as.number == 1.0);
+    value.flags = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_iter_next(&iter, &key, &value), JSON_INCITER_OK);
+    assert_memory_equal(key.start, "\"b\"", key.length);
+    assert_int_equal(value.tag, JSON_INCITER_ELEMENT_TAG_ARRAY);
+    assert_int_equal(json_inciter_iter_next(&iter, &key, &value), JSON_INCITER_OK);
+    assert_memory_equal(key.start, "\"\\\"\"", key.length);
+    assert_int_equal(value.tag, JSON_INCITER_ELEMENT_TAG_OBJECT);
+    assert_int_equal(json_inciter_iter_next(&iter, &key, &value), JSON_INCITER_DONE);
+    assert_int_equal(json_inciter_iter_next(&iter, &key, &value), JSON_INCITER_DONE);
+    assert_int_equal(iter.offset, container.length);
+
+    // Arrays, nested iterators on lazy containers
+    size_t count = 0;
+    value.flags  = 0;
+    assert_int_equal(json_inciter_parse_value("[[], [1, 2], 3]", &container), JSON_INCITER_OK);
+    json_inciter_iter_init(&iter, container);
+    while (json_inciter_iter_next(&iter, NULL, &value) == JSON_INCITER_OK) {
+        json_inciter_iter_t    nested;
+        json_inciter_element_t element = {0};
+        if (json_inciter_iter_init(&nested, value) == JSON_INCITER_OK) {
+            while (json_inciter_iter_next(&nested, NULL, &element) == JSON_INCITER_OK) {
+                count += (size_t)element.as.number;
+            }
+        } else {
+            count += (size_t)value.as.number;
+        }
+    }
+    assert_int_equal(count, 6);
+
+    // The iterator does not move on errors, and resumes once the stream grows
+    const char *stream = "[1, \"ab\"]";
+    container.tag      = JSON_INCITER_ELEMENT_TAG_ARRAY;
+    container.start    = stream;
+    container.length   = 6;
+    json_inciter_iter_init(&iter, container);
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_INCOMPLETE);
+    iter.length = 9;
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_OK);
+    assert_int_equal(value.tag, JSON_INCITER_ELEMENT_TAG_STRING);
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_DONE);
+
+    // Nor on a number cut by the end of the stream, which may go on
+    stream           = "[12345, 6]";
+    container.start  = stream;
+    container.length = 4;
+    json_inciter_iter_init(&iter, container);
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(iter.offset, 1);
+    iter.length = 7;
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_OK);
+    assert_true(value.as.number == 12345.0);
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_INCOMPLETE);
+    iter.length = 10;
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_OK);
+    assert_true(value.as.number == 6.0);
+    assert_int_equal(json_inciter_iter_next(&iter, NULL, &value), JSON_INCITER_DONE);
+
+    const char *invalid[] = {"[1 2]", "[1,]", "[,1]", "{\"a\" 1}", "{1: 2}", "{\"a\": 1,}", "[1}"};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        json_inciter_t result = JSON_INCITER_OK;
+        container.tag         = invalid[i][0] == '[' ? JSON_INCITER_ELEMENT_TAG_ARRAY : JSON_INCITER_ELEMENT_TAG_OBJECT;
+        container.start       = invalid[i];
+        container.length      = strlen(invalid[i]);
+        json_inciter_iter_init(&iter, container);
+        while ((result = json_inciter_iter_next(&iter, &key, &value)) == JSON_INCITER_OK) {
+        }
+        assert_int_equal(result, JSON_INCITER_INVALID);
+    }
+
+    assert_int_equal(json_inciter_parse_value("\"s\"", &container), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_iter_init(&iter, container), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_parse_value("{ }", &container), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_find_value_in_object(container, "a", &value), JSON_INCITER_DONE);
+}
+
+
+typedef struct {
+    char   out[512];
+    size_t out_len;
+    size_t flushes;
+} test_sink_t;
+
+
+// Collect the output of a writer, failing once it does not fit
+static json_inciter_t test_sink_flush(void *context, const char *data, size_t length) {
+    test_sink_t *sink = context;
+
+    if (sink->out_len + length >= sizeof(sink->out)) {
+        return JSON_INCITER_OVERFLOW;
+    }
+    memcpy(&sink->out[sink->out_len], data, length);
+    sink->out_len += length;
+    sink->out[sink->out_len] = '\0';
+    sink->flushes++;
+    return JSON_INCITER_OK;
+}
+
+
+// Write the same document with any writer
+static json_inciter_t test_write_document(json_inciter_writer_t *writer, json_inciter_element_t forwarded) {
+    json_inciter_write_begin_object(writer);
+    json_inciter_write_key(writer, "a");
+    json_inciter_write_begin_array(writer);
+    json_inciter_write_int64(writer, 1);
+    json_inciter_write_int64(writer, INT64_MIN);
+    json_inciter_write_uint64(writer, UINT64_MAX);
+    json_inciter_write_bool(writer, 1);
+    json_inciter_write_bool(writer, 0);
+    json_inciter_write_null(writer);
+    json_inciter_write_string(writer, "q\"b\\\n\t\x01\xc3\xa9 a string long enough to be scanned by vectors");
+    json_inciter_write_end_array(writer);
+    json_inciter_write_key_n(writer, "k\"", 2);
+    json_inciter_write_begin_object(writer);
+    json_inciter_write_key(writer, "d");
+    json_inciter_write_double(writer, 0.1);
+    json_inciter_write_end_object(writer);
+    json_inciter_write_key(writer, "e");
+    json_inciter_write_element(writer, forwarded);
+    json_inciter_write_key(writer, "f");
+    json_inciter_write_begin_array(writer);
+    json_inciter_write_end_array(writer);
+    return json_inciter_write_end_object(writer);
+}
+
+
+static void test_json_inciter_writer(void **state) {
+    (void)state;
+    const char *expected = "{\"a\":[1,-9223372036854775808,18446744073709551615,true,false,null,"
+                           "\"q\\\"b\\\\\\n\\t\\u0001\xc3\xa9 a string long enough to be scanned by vectors\"],"
+                           "\"k\\\"\":{\"d\":0.1},\"e\":[1, {\"x\": \"y\"}],\"f\":[]}";
+    json_inciter_element_t forwarded = {0};
+    json_inciter_element_t element   = {0};
+    json_inciter_writer_t  writer;
+    test_sink_t            sink      = {{0}, 0, 0};
+    char                   buffer[256];
+    char                   small[8];
+    char                   deep[JSON_INCITER_MAX_DEPTH];
+
+    forwarded.flags = JSON_INCITER_FLAG_LAZY_CONTAINERS;
+    assert_int_equal(json_inciter_parse_value(" [1, {\"x\": \"y\"}] , 2", &forwarded), JSON_INCITER_OK);
+
+    // Fixed buffer
+    json_inciter_writer_init(&writer, buffer, sizeof(buffer), NULL, NULL);
+    assert_int_equal(test_write_document(&writer, forwarded), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_writer_flush(&writer), JSON_INCITER_OK);
+    assert_int_equal(writer.used, strlen(expected));
+    assert_memory_equal(buffer, expected, writer.used);
+    assert_int_equal(json_inciter_validate_n(buffer, writer.used), JSON_INCITER_OK);
+
+    // Flushed from a small buffer, long strings going straight to the callback
+    json_inciter_writer_init(&writer, small, sizeof(small), test_sink_flush, &sink);
+    assert_int_equal(test_write_document(&writer, forwarded), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_writer_flush(&writer), JSON_INCITER_OK);
+    assert_int_equal(sink.out_len, strlen(expected));
+    assert_memory_equal(sink.out, expected, sink.out_len);
+    assert_true(sink.flushes > 2);
+
+    // Values at the root are separated by newlines, and read back as records
+    json_inciter_records_t records;
+    json_inciter_writer_init(&writer, buffer, sizeof(buffer), NULL, NULL);
+    json_inciter_write_int64(&writer, -5);
+    assert_int_equal(json_inciter_write_key_element(&writer, forwarded), JSON_INCITER_INVALID);
+    json_inciter_write_string_n(&writer, "a\0b", 3);
+    assert_int_equal(writer.error, JSON_INCITER_OK);
+    assert_int_equal(writer.used, 13);
+    assert_memory_equal(buffer, "-5\n\"a\\u0000b\"", writer.used);
+    json_inciter_records_init_n(&records, buffer, writer.used);
+    assert_int_equal(json_inciter_records_next(&records, &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_records_next(&records, &element), JSON_INCITER_OK);
+    assert_int_equal(element.tag, JSON_INCITER_ELEMENT_TAG_STRING);
+
+    // Keys and forwarded keys only go in objects, before their value; errors stick
+    json_inciter_writer_init(&writer, buffer, sizeof(buffer), NULL, NULL);
+    assert_int_equal(json_inciter_write_begin_object(&writer), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_parse_value("\"k\\n\"", &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_write_key_element(&writer, forwarded), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_write_key_element(&writer, element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_write_double(&writer, 1.0 / 0.0), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_write_double(&writer, -1.5e300), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_write_end_object(&writer), JSON_INCITER_OK);
+    assert_int_equal(writer.used, 16);
+    assert_memory_equal(buffer, "{\"k\\n\":-1.5e300}", writer.used);
+
+    const char *invalid[] = {"key in array", "value without key", "end of array in object", "end at root",
+                             "end after key"};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        json_inciter_writer_init(&writer, buffer, sizeof(buffer), NULL, NULL);
+        if (i == 0) {
+            json_inciter_write_begin_array(&writer);
+            json_inciter_write_key(&writer, "k");
+        } else if (i == 1) {
+            json_inciter_write_begin_object(&writer);
+            json_inciter_write_null(&writer);
+        } else if (i == 2) {
+            json_inciter_write_begin_object(&writer);
+            json_inciter_write_end_array(&writer);
+        } else if (i == 3) {
+            json_inciter_write_end_object(&writer);
+        } else {
+            json_inciter_write_begin_object(&writer);
+            json_inciter_write_key(&writer, "k");
+            json_inciter_write_end_object(&writer);
+        }
+        assert_int_equal(writer.error, JSON_INCITER_INVALID);
+        assert_int_equal(json_inciter_write_null(&writer), JSON_INCITER_INVALID);
+    }
+
+    // Full fixed buffers, failing callbacks and deep nesting
+    json_inciter_writer_init(&writer, small, sizeof(small), NULL, NULL);
+    assert_int_equal(json_inciter_write_string(&writer, "too long"), JSON_INCITER_OVERFLOW);
+    assert_int_equal(json_inciter_write_null(&writer), JSON_INCITER_OVERFLOW);
+    sink.out_len = sizeof(sink.out) - 4;
+    json_inciter_writer_init(&writer, small, sizeof(small), test_sink_flush, &sink);
+    assert_int_equal(json_inciter_write_string(&writer, "too long"), JSON_INCITER_OVERFLOW);
+    json_inciter_writer_init(&writer, deep, sizeof(deep), NULL, NULL);
+    for (size_t i = 0; i < JSON_INCITER_MAX_DEPTH; i++) {
+        assert_int_equal(json_inciter_write_begin_array(&writer), JSON_INCITER_OK);
+    }
+    assert_int_equal(json_inciter_write_begin_array(&writer), JSON_INCITER_OVERFLOW);
+
+    // Doubles are written with the fewest digits that read back to them, without exponents from 10^-4 to 10^16
+    const struct {
+        double      value;
+        const char *text;
+    } doubles[] = {
+        {0.0, "0"},
+        {-0.0, "-0"},
+        {0.3, "0.3"},
+        {1.0 / 3, "0.3333333333333333"},
+        {-2.5, "-2.5"},
+        {100, "100"},
+        {1e15, "1000000000000000"},
+        {1e16, "1e16"},
+        {1.25e-3, "0.00125"},
+        {1e-4, "0.0001"},
+        {1e-5, "1e-5"},
+        {123456.789, "123456.789"},
+        {9007199254740992.0, "9007199254740992"},
+        {5e-324, "5e-324"},
+        {2.2250738585072014e-308, "2.2250738585072014e-308"},
+        {DBL_MAX, "1.7976931348623157e308"},
+        {1e23, "1e23"},
+        {8.41e21, "8.41e21"},
+        {5.0e-324 * 3, "1.5e-323"},
+    };
+    for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+        json_inciter_writer_init(&writer, buffer, sizeof(buffer), NULL, NULL);
+        assert_int_equal(json_inciter_write_double(&writer, doubles[i].value), JSON_INCITER_OK);
+        buffer[writer.used] = '\0';
+        assert_string_equal(buffer, doubles[i].text);
+    }
+
+    // Any finite double reads back exactly, with no more significant digits than printf needs
+    uint64_t bits = 88172645463325252ULL;
+    for (size_t i = 0; i < 20000; i++) {
+        double value = 0;
+        double back  = 0;
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        memcpy(&value, &bits, sizeof(value));
+        if (value != value || value - value != 0) {
+            continue;
+        }
+        json_inciter_writer_init(&writer, buffer, sizeof(buffer), NULL, NULL);
+        assert_int_equal(json_inciter_write_double(&writer, value), JSON_INCITER_OK);
+        buffer[writer.used] = '\0';
+        assert_int_equal(json_inciter_parse_value(buffer, &element), JSON_INCITER_OK);
+        back = element.as.number;
+        assert_memory_equal(&back, &value, sizeof(value));
+
+        size_t significant = 0;
+        size_t zeros       = 0;
+        for (const char *c = buffer; *c != '\0' && *c != 'e'; c++) {
+            if (*c == '0') {
+                zeros += significant > 0;
+            } else if (*c >= '1' && *c <= '9') {
+                significant += zeros + 1;
+                zeros = 0;
+            }
+        }
+        int precision = 1;
+        for (char printed[32]; precision < 17; precision++) {
+            snprintf(printed, sizeof(printed), "%.*e", precision - 1, value);
+            if (strtod(printed, NULL) == value) {
+                break;
+            }
+        }
+        assert_true(significant <= (size_t)precision);
+    }
+}
+
+
+#ifdef JSON_INCITER_STATS
+static void test_json_inciter_stats(void **state) {
+    (void)state;
+    const char            *json_buffer = "{\"a\": 1, \"b\": [true, null], \"c\": 2.5}";
+    json_inciter_element_t root        = {0};
+    json_inciter_element_t element     = {0};
+    json_inciter_stats_t   stats;
+
+    json_inciter_stats_reset();
+    assert_int_equal(json_inciter_parse_value(json_buffer, &root), JSON_INCITER_OK);
+    json_inciter_stats_snapshot(&stats);
+    assert_int_equal(stats.calls[JSON_INCITER_STATS_PARSE], 1);
+    assert_int_equal(stats.bytes[JSON_INCITER_STATS_PARSE], strlen(json_buffer));
+    assert_int_equal(stats.container_scans, 1);
+    assert_int_equal(stats.container_scan_bytes, strlen(json_buffer) - 2);
+
+    // Containers long enough for the vectorized scan are counted the same way
+    static char long_array[512];
+    memset(long_array, ' ', sizeof(long_array) - 1);
+    memcpy(long_array, "[\"a]\", [{}], 1", 14);
+    long_array[sizeof(long_array) - 2] = ']';
+    json_inciter_stats_reset();
+    assert_int_equal(json_inciter_parse_value(long_array, &element), JSON_INCITER_OK);
+    json_inciter_stats_snapshot(&stats);
+    assert_int_equal(stats.container_scans, 1);
+    assert_int_equal(stats.container_scan_bytes, sizeof(long_array) - 3);
+
+    // Only the value found is converted, the array is skipped without checking its literals
+    json_inciter_stats_reset();
+    assert_int_equal(json_inciter_find_value_in_object(root, "c", &element), JSON_INCITER_OK);
+    json_inciter_stats_snapshot(&stats);
+    assert_int_equal(stats.calls[JSON_INCITER_STATS_FIND], 1);
+    assert_int_equal(stats.calls[JSON_INCITER_STATS_ITER], 3);
+    assert_int_equal(stats.bytes[JSON_INCITER_STATS_FIND], strlen(json_buffer) - 1);
+    assert_int_equal(stats.number_conversions, 1);
+    assert_int_equal(stats.literal_checks, 0);
+
+    json_inciter_continuation_t continuation = {0};
+    json_inciter_stats_reset();
+    assert_int_equal(json_inciter_parse_value_resume_n("[tr", 3, &continuation, &element), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter_parse_value_resume_n("[true]", 6, &continuation, &element), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_validate("[true]"), JSON_INCITER_OK);
+    json_inciter_stats_snapshot(&stats);
+    assert_int_equal(stats.incomplete, 1);
+    assert_int_equal(stats.resumes, 1);
+    assert_int_equal(stats.calls[JSON_INCITER_STATS_VALIDATE], 1);
+    assert_int_equal(stats.literal_checks, 1);
+
+    // Bound counters take the place of the thread's own
+    json_inciter_stats_t bound = {0};
+    test_walk_context_t  walk  = {.skip = "-"};
+    json_inciter_stats_bind(&bound);
+    assert_int_equal(json_inciter_walk(json_buffer, 0, test_walk_callback, &walk), JSON_INCITER_OK);
+    json_inciter_stats_bind(NULL);
+    assert_int_equal(bound.calls[JSON_INCITER_STATS_WALK], 1);
+    assert_int_equal(bound.bytes[JSON_INCITER_STATS_WALK], strlen(json_buffer));
+    json_inciter_stats_snapshot(&stats);
+    assert_int_equal(stats.calls[JSON_INCITER_STATS_WALK], 0);
+    assert_string_equal(json_inciter_stats_api_name(JSON_INCITER_STATS_WALK), "walk");
+
+#ifdef JSON_INCITER_THREADS
+    // The counters of the threads of the pool are added to the caller's
+    const char            *ndjson = "{\"id\": 1}\n{\"id\": 2}\n{\"id\": 3}\n{\"id\": 4}\n";
+    test_records_context_t totals[4];
+    void                  *contexts[4];
+    memset(totals, 0, sizeof(totals));
+    for (size_t i = 0; i < 4; i++) {
+        contexts[i] = &totals[i];
+    }
+    json_inciter_stats_reset();
+    assert_int_equal(json_inciter_records_parallel_n(ndjson, strlen(ndjson), 0, 4, 1, test_records_callback, contexts),
+                     JSON_INCITER_OK);
+    json_inciter_stats_snapshot(&stats);
+    assert_int_equal(stats.bytes[JSON_INCITER_STATS_RECORDS], strlen(ndjson));
+#endif
+}
+#endif
+
+
+#ifdef JSON_INCITER_MMAP
+static void test_json_inciter_file_map(void **state) {
+    (void)state;
+    json_inciter_file_t    file    = {0};
+    json_inciter_element_t root    = {0};
+    json_inciter_element_t element = {0};
+
+    assert_int_equal(json_inciter_file_map("api.json", &file), JSON_INCITER_OK);
+    assert_true(file.length > 0);
+    assert_int_equal(json_inciter_parse_value_n(file.buffer, file.length, &root), JSON_INCITER_OK);
+    assert_int_equal(root.tag, JSON_INCITER_ELEMENT_TAG_OBJECT);
+    assert_int_equal(json_inciter_validate_n(file.buffer, file.length), JSON_INCITER_OK);
+    assert_int_equal(json_inciter_find_path_n(file.buffer, file.length, "/assets_url", &element), JSON_INCITER_OK);
+    json_inciter_file_unmap(&file);
+    assert_int_equal(file.length, 0);
+
+    assert_int_equal(json_inciter_file_map("missing.json", &file), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter_parse_value_n(file.buffer, file.length, &root), JSON_INCITER_INCOMPLETE);
+}
+#endif
+
 
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_json_inciter_null),   cmocka_unit_test(test_json_inciter_true),
         cmocka_unit_test(test_json_inciter_false),  cmocka_unit_test(test_json_inciter_number),
+        cmocka_unit_test(test_json_inciter_number_conversion),
         cmocka_unit_test(test_json_inciter_string), cmocka_unit_test(test_json_inciter_array),
         cmocka_unit_test(test_json_inciter_object), cmocka_unit_test(test_json_inciter_api_extraction),
+        cmocka_unit_test(test_json_inciter_bounded), cmocka_unit_test(test_json_inciter_resume),
+        cmocka_unit_test(test_json_inciter_vectorized_scan), cmocka_unit_test(test_json_inciter_lazy_numbers),
+        cmocka_unit_test(test_json_inciter_find_values), cmocka_unit_test(test_json_inciter_find_path),
+        cmocka_unit_test(test_json_inciter_lazy_containers), cmocka_unit_test(test_json_inciter_tape),
+        cmocka_unit_test(test_json_inciter_key_index), cmocka_unit_test(test_json_inciter_precompiled_keys),
+        cmocka_unit_test(test_json_inciter_bind_object), cmocka_unit_test(test_json_inciter_copy_string),
+        cmocka_unit_test(test_json_inciter_validate), cmocka_unit_test(test_json_inciter_records),
+        cmocka_unit_test(test_json_inciter_array_partition), cmocka_unit_test(test_json_inciter_segments),
+        cmocka_unit_test(test_json_inciter_walk), cmocka_unit_test(test_json_inciter_iter),
+        cmocka_unit_test(test_json_inciter_writer),
+#ifdef JSON_INCITER_STATS
+        cmocka_unit_test(test_json_inciter_stats),
+#endif
+#ifdef JSON_INCITER_MMAP
+        cmocka_unit_test(test_json_inciter_file_map),
+#endif
     };
 
     /* If setup and teardown functions are not
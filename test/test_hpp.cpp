@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "json_inciter.hpp"
+
+using namespace json_inciter::literals;
+
+
+// Keys hashed at compile time, checked against the C precompiled keys
+static constexpr json_inciter::key precompiled_id("id");
+static constexpr json_inciter::key precompiled_long = "components_and_more"_key;
+static_assert(precompiled_id.c_key().length == 2, "key length is computed at compile time");
+static_assert(precompiled_long.c_key().hash != 0, "key hash is computed at compile time");
+
+
+static void test_json_inciter_hpp_keys(void **state) {
+    (void)state;
+    json_inciter_key_t expected = JSON_INCITER_KEY("id");
+    assert_int_equal(precompiled_id.c_key().length, expected.length);
+    assert_int_equal(precompiled_id.c_key().prefix, expected.prefix);
+    assert_int_equal(precompiled_id.c_key().hash, expected.hash);
+
+    expected = JSON_INCITER_KEY("components_and_more");
+    assert_int_equal(precompiled_long.c_key().length, expected.length);
+    assert_int_equal(precompiled_long.c_key().prefix, expected.prefix);
+    assert_int_equal(precompiled_long.c_key().hash, expected.hash);
+
+    // Keys built at run time, from buffers longer than the key
+    assert_int_equal(json_inciter::key(std::string_view("id")).c_key().hash, precompiled_id.c_key().hash);
+    char buffer[16] = "id";
+    assert_int_equal(json_inciter::key(buffer).c_key().length, 2);
+    assert_int_equal(json_inciter::key(buffer).c_key().hash, precompiled_id.c_key().hash);
+}
+
+
+static void test_json_inciter_hpp_lookup(void **state) {
+    (void)state;
+    const char *json = " {\"id\": 42, \"name\": \"a\\\"b\", \"ratio\": -0.5, \"big\": 300, \"ok\": true, "
+                       "\"nested\": {\"components_and_more\": [1, 2]}} ";
+    json_inciter::value root = json_inciter::value::parse(json);
+    char                copy[8];
+
+    assert_true(root.is_object());
+    assert_int_equal(root.raw().size(), strlen(json) - 2);
+    assert_int_equal(root[precompiled_id].get<int>().value, 42);
+    assert_int_equal(root["id"].get<uint64_t>().value, 42);
+    assert_true(root["ratio"].get<double>().value == -0.5);
+    assert_true(root["ratio"].get<float>().value == -0.5f);
+    assert_true(root["ok"].get<bool>().value);
+    assert_true(root[std::string_view("nested")][precompiled_long].is_array());
+    assert_true(root["name"].string() == "a\\\"b");
+    assert_int_equal(root["name"].copy_string(copy, sizeof(copy)), JSON_INCITER_OK);
+    assert_string_equal(copy, "a\"b");
+
+    // Keys in buffers longer than them, or behind pointers
+    char        buffer[16] = "ratio";
+    const char *pointer    = buffer;
+    assert_true(root[buffer].get<double>().value == -0.5);
+    assert_true(root[pointer].get<double>().value == -0.5);
+
+    // Conversions are checked against the range of the type
+    assert_int_equal(root["big"].get<int8_t>().error, JSON_INCITER_OVERFLOW);
+    assert_int_equal(root["big"].get<uint16_t>().value, 300);
+    assert_int_equal(root["id"].get<bool>().error, JSON_INCITER_INVALID);
+    assert_int_equal(root["ratio"].get<int>().error, JSON_INCITER_INVALID);
+    assert_int_equal(root["name"].get<unsigned>().error, JSON_INCITER_INVALID);
+
+    // Errors carry through lookups
+    assert_int_equal(root["missing"].error(), JSON_INCITER_DONE);
+    assert_int_equal(root["missing"]["id"].get<int>().error, JSON_INCITER_DONE);
+    assert_int_equal(root["missing"]["id"].get<int>().value_or(7), 7);
+    assert_int_equal(root["id"]["id"].error(), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter::value::parse("{\"id\": ").error(), JSON_INCITER_INCOMPLETE);
+    assert_int_equal(json_inciter::value::parse("nux").error(), JSON_INCITER_INVALID);
+    assert_int_equal(json_inciter::value::parse(std::string_view("125", 2)).get<int>().value, 12);
+    assert_true(root["missing"].raw().empty());
+}
+
+
+static void test_json_inciter_hpp_iteration(void **state) {
+    (void)state;
+    json_inciter::value root = json_inciter::value::parse("{\"a\": [1, [2, 3], 4], \"b\": {\"c\": 5}, \"d\": []}",
+                                                          JSON_INCITER_FLAG_LAZY_CONTAINERS);
+    size_t              count = 0;
+    int                 sum   = 0;
+
+    for (json_inciter::member member : root.members()) {
+        assert_true(member.value.ok());
+        count += member.key.string().size();
+    }
+    assert_int_equal(count, 3);
+
+    for (json_inciter::value element : root["a"].elements()) {
+        if (element.is_array()) {
+            for (json_inciter::value nested : element.elements()) {
+                sum += nested.get<int>().value;
+            }
+        } else {
+            sum += element.get<int>().value;
+        }
+    }
+    assert_int_equal(sum, 10);
+    assert_true(root["a"].raw() == "[1, [2, 3], 4]");
+    assert_int_equal(root["b"]["c"].get<int>().value, 5);
+
+    // Missing and empty containers have no members, the others are reported once
+    count = 0;
+    for (json_inciter::value element : root["d"].elements()) {
+        (void)element;
+        count++;
+    }
+    for (json_inciter::value element : root["missing"].elements()) {
+        (void)element;
+        count++;
+    }
+    assert_int_equal(count, 0);
+    for (json_inciter::value element : root["b"].elements()) {
+        assert_int_equal(element.error(), JSON_INCITER_INVALID);
+        count++;
+    }
+    for (json_inciter::value element : json_inciter::value::parse("[1, 2,]", JSON_INCITER_FLAG_LAZY_CONTAINERS)
+                                           .elements()) {
+        count += element.ok() ? 1 : 10;
+    }
+    assert_int_equal(count, 13);
+}
+
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_json_inciter_hpp_keys),
+        cmocka_unit_test(test_json_inciter_hpp_lookup),
+        cmocka_unit_test(test_json_inciter_hpp_iteration),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}